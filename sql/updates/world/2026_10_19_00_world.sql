@@ -0,0 +1,4 @@
+--
+DELETE FROM `command` WHERE `name`='server dbstats';
+INSERT INTO `command` (`name`,`permission`,`help`) VALUES
+('server dbstats',1000,'Syntax: .server dbstats [login|world|character|reset] [#count]\r\n\r\nShow the async queue depth and the #count (default 10) most expensive prepared statements of the given database, or of all databases if none is given. Use reset to clear the counters.');
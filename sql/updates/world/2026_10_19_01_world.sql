@@ -0,0 +1,4 @@
+--
+DELETE FROM `command` WHERE `name`='debug combat';
+INSERT INTO `command` (`name`,`permission`,`help`) VALUES
+('debug combat',1001,'Syntax: .debug combat #spellid [#iterations]\r\n\r\nRun the melee damage, spell bonus, absorb/resist, aura multiplier and CheckCast calculations of #spellid #iterations (default 10000) times against the selected unit, with the auras you and the target currently have, and show the time per call. Absorb shields of the target are used up like in real combat.');
@@ -244,6 +244,55 @@ void BIH::subdivide(int left, int right, std::vector<uint32> &tempTree, buildDat
         stats.updateLeaf(depth + 1, 0);
 }
 
+void BIH::refitNode(uint32 node, const std::vector<AABound> &primBounds, AABound &nodeBound)
+{
+    // stays inverted for subtrees without objects, their clips then keep rays out
+    nodeBound.lo = G3D::Vector3(G3D::finf(), G3D::finf(), G3D::finf());
+    nodeBound.hi = G3D::Vector3(-G3D::finf(), -G3D::finf(), -G3D::finf());
+
+    uint32 tn = tree[node];
+    uint32 axis = (tn & (3 << 30)) >> 30;
+    bool BVH2 = (tn & (1 << 29)) != 0;
+    uint32 offset = tn & ~(7 << 29);
+
+    if (axis == 3)
+    {
+        // leaf
+        uint32 n = tree[node + 1];
+        for (uint32 i = 0; i < n; ++i)
+        {
+            const AABound& primBound = primBounds[objects[offset + i]];
+            nodeBound.lo = nodeBound.lo.min(primBound.lo);
+            nodeBound.hi = nodeBound.hi.max(primBound.hi);
+        }
+        return;
+    }
+
+    if (BVH2)
+    {
+        refitNode(offset, primBounds, nodeBound);
+        tree[node + 1] = floatToRawIntBits(nodeBound.lo[axis]);
+        tree[node + 2] = floatToRawIntBits(nodeBound.hi[axis]);
+        return;
+    }
+
+    // a missing child was written with an infinite clip, the offset of the other one was adjusted for it
+    AABound boundL = nodeBound, boundR = nodeBound;
+    if (intBitsToFloat(tree[node + 1]) != -G3D::finf())
+    {
+        refitNode(offset, primBounds, boundL);
+        tree[node + 1] = floatToRawIntBits(boundL.hi[axis]);
+    }
+    if (intBitsToFloat(tree[node + 2]) != G3D::finf())
+    {
+        refitNode(offset + 3, primBounds, boundR);
+        tree[node + 2] = floatToRawIntBits(boundR.lo[axis]);
+    }
+
+    nodeBound.lo = boundL.lo.min(boundR.lo);
+    nodeBound.hi = boundL.hi.max(boundR.hi);
+}
+
 bool BIH::writeToFile(FILE* wf) const
 {
     uint32 treeSize = tree.size();
@@ -30,8 +30,11 @@
 #include <algorithm>
 #include <limits>
 #include <cmath>
+#include <emmintrin.h>
 
 #define MAX_STACK_SIZE 64
+#define BIH_PACKET_SIZE 4                               // rays per packet, one SSE register
+#define BIH_PACKET_MASK ((1 << BIH_PACKET_SIZE) - 1)
 
 static inline uint32 floatToRawIntBits(float f)
 {
@@ -55,11 +58,43 @@ static inline float intBitsToFloat(uint32 i)
     return temp.fval;
 }
 
+// a where mask is set, b elsewhere
+static inline __m128 selectLanes(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
 struct AABound
 {
     G3D::Vector3 lo, hi;
 };
 
+/** Up to BIH_PACKET_SIZE rays intersected together by BIH::intersectRayPacket.
+    Lane i of every per-lane array and mask belongs to rays[i].
+*/
+struct RayPacket
+{
+    RayPacket(const G3D::Ray* r, uint32 n) : count(n)
+    {
+        for (uint32 lane = 0; lane < BIH_PACKET_SIZE; ++lane)
+        {
+            // unused lanes repeat the first ray, they are never active
+            rays[lane] = r[lane < n ? lane : 0];
+            for (int i=0; i<3; ++i)
+            {
+                org[i][lane] = rays[lane].origin()[i];
+                dir[i][lane] = rays[lane].direction()[i];
+            }
+        }
+    }
+
+    G3D::Ray rays[BIH_PACKET_SIZE];
+    uint32 count;
+    // the same rays as structure of arrays for SSE
+    float org[3][BIH_PACKET_SIZE];
+    float dir[3][BIH_PACKET_SIZE];
+};
+
 /** Bounding Interval Hierarchy Class.
     Building and Ray-Intersection functions based on BIH from
     Sunflow, a Java Raytracer, released under MIT/X11 License
@@ -117,6 +152,30 @@ class BIH
         }
         uint32 primCount() const { return objects.size(); }
 
+        /** Moves the clip planes to the current bounds of the primitives, the hierarchy itself is kept.
+            Much cheaper than build when primitives moved, but rays visit more nodes the further they
+            moved, so the caller builds again from time to time. The primitives must be the ones of the last build.
+        */
+        template< class BoundsFunc, class PrimArray >
+        void refit(const PrimArray &primitives, BoundsFunc &getBounds)
+        {
+            if (objects.empty())
+                return;
+
+            std::vector<AABound> primBounds(primitives.size());
+            G3D::AABox box;
+            for (uint32 i=0; i<primBounds.size(); ++i)
+            {
+                getBounds(primitives[i], box);
+                primBounds[i].lo = box.low();
+                primBounds[i].hi = box.high();
+            }
+
+            AABound treeBound;
+            refitNode(0, primBounds, treeBound);
+            bounds = G3D::AABox(treeBound.lo, treeBound.hi);
+        }
+
         template<typename RayCallback>
         void intersectRay(const G3D::Ray &r, RayCallback& intersectCallback, float &maxDist, bool stopAtFirst=false) const
         {
@@ -334,6 +393,187 @@ class BIH
             }
         }
 
+        /** Same as intersectRay for all rays of the packet selected by mask, in a single traversal.
+            Each lane keeps its own interval and maxDist, maxDist has BIH_PACKET_SIZE entries.
+            intersectCallback(entry, maxDist, mask, stopAtFirst) tests the object for the lanes in mask
+            and returns the lanes that hit it.
+        */
+        template<typename RayPacketCallback>
+        void intersectRayPacket(const RayPacket &packet, RayPacketCallback& intersectCallback, float* maxDist, uint32 mask, bool stopAtFirst=false) const
+        {
+            mask &= (1 << packet.count) - 1;
+
+            // clip each ray against the tree bounds, empty intervals for lanes that miss them
+            float laneMin[BIH_PACKET_SIZE];
+            float laneMax[BIH_PACKET_SIZE];
+            for (uint32 lane = 0; lane < BIH_PACKET_SIZE; ++lane)
+            {
+                laneMin[lane] = 1.f;
+                laneMax[lane] = 0.f;
+                if (!(mask & (1 << lane)))
+                    continue;
+
+                float intervalMin = -1.f;
+                float intervalMax = -1.f;
+                bool miss = false;
+                for (int i=0; i<3 && !miss; ++i)
+                {
+                    float org = packet.org[i][lane];
+                    float dir = packet.dir[i][lane];
+                    if (G3D::fuzzyNe(dir, 0.0f))
+                    {
+                        float invDir = 1.f / dir;
+                        float t1 = (bounds.low()[i]  - org) * invDir;
+                        float t2 = (bounds.high()[i] - org) * invDir;
+                        if (t1 > t2)
+                            std::swap(t1, t2);
+                        if (t1 > intervalMin)
+                            intervalMin = t1;
+                        if (t2 < intervalMax || intervalMax < 0.f)
+                            intervalMax = t2;
+                        if (intervalMax <= 0 || intervalMin >= maxDist[lane])
+                            miss = true;
+                    }
+                }
+
+                if (miss || intervalMin > intervalMax)
+                {
+                    mask &= ~(1 << lane);
+                    continue;
+                }
+
+                laneMin[lane] = std::max(intervalMin, 0.f);
+                laneMax[lane] = std::min(intervalMax, maxDist[lane]);
+            }
+
+            if (!mask)
+                return;
+
+            __m128 org[3];
+            __m128 invDir[3];
+            __m128 negative[3];
+            for (int i=0; i<3; ++i)
+            {
+                __m128 dir = _mm_loadu_ps(packet.dir[i]);
+                org[i] = _mm_loadu_ps(packet.org[i]);
+                invDir[i] = _mm_div_ps(_mm_set1_ps(1.f), dir);
+                // lanes going down the axis, by sign bit like intersectRay
+                negative[i] = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(dir), 31));
+            }
+
+            // children are visited in the order of the first active ray, the others only lose early outs
+            uint32 first = 0;
+            while (!(mask & (1 << first)))
+                ++first;
+
+            uint32 firstNegative[3];
+            for (int i=0; i<3; ++i)
+                firstNegative[i] = floatToRawIntBits(packet.dir[i][first]) >> 31;
+
+            // lanes with a hit that stops them or that were never active
+            uint32 done = ~mask & BIH_PACKET_MASK;
+            __m128 intervalMin = _mm_loadu_ps(laneMin);
+            __m128 intervalMax = _mm_loadu_ps(laneMax);
+
+            PacketStackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+            int node = 0;
+
+            while (true) {
+                while (true)
+                {
+                    uint32 tn = tree[node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    bool BVH2 = (tn & (1 << 29)) != 0;
+                    int offset = tn & ~(7 << 29);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node
+                            __m128 tl = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(intBitsToFloat(tree[node + 1])), org[axis]), invDir[axis]);
+                            __m128 tr = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(intBitsToFloat(tree[node + 2])), org[axis]), invDir[axis]);
+                            // intervals of each ray in both children, front and back are swapped for lanes going down the axis
+                            __m128 leftMin = selectLanes(negative[axis], _mm_max_ps(tl, intervalMin), intervalMin);
+                            __m128 leftMax = selectLanes(negative[axis], intervalMax, _mm_min_ps(tl, intervalMax));
+                            __m128 rightMin = selectLanes(negative[axis], intervalMin, _mm_max_ps(tr, intervalMin));
+                            __m128 rightMax = selectLanes(negative[axis], _mm_min_ps(tr, intervalMax), intervalMax);
+                            uint32 left = _mm_movemask_ps(_mm_cmple_ps(leftMin, leftMax)) & ~done;
+                            uint32 right = _mm_movemask_ps(_mm_cmple_ps(rightMin, rightMax)) & ~done;
+                            // rays pass between clip zones
+                            if (!left && !right)
+                                break;
+                            // rays pass through one node only
+                            if (!left || !right)
+                            {
+                                node = left ? offset : offset + 3;
+                                intervalMin = left ? leftMin : rightMin;
+                                intervalMax = left ? leftMax : rightMax;
+                                continue;
+                            }
+                            // rays pass through both nodes
+                            // push back the far node of the first ray
+                            bool frontRight = firstNegative[axis] != 0;
+                            stack[stackPos].node = frontRight ? offset : offset + 3;
+                            stack[stackPos].tnear = frontRight ? leftMin : rightMin;
+                            stack[stackPos].tfar = frontRight ? leftMax : rightMax;
+                            stackPos++;
+                            node = frontRight ? offset + 3 : offset;
+                            intervalMin = frontRight ? rightMin : leftMin;
+                            intervalMax = frontRight ? rightMax : leftMax;
+                            continue;
+                        }
+                        else
+                        {
+                            // leaf - test some objects
+                            uint32 active = _mm_movemask_ps(_mm_cmple_ps(intervalMin, intervalMax)) & ~done;
+                            int n = tree[node + 1];
+                            while (n > 0 && active) {
+                                uint32 hit = intersectCallback(objects[offset], maxDist, active, stopAtFirst);
+                                if (stopAtFirst && hit)
+                                {
+                                    done |= hit;
+                                    if (done == BIH_PACKET_MASK)
+                                        return;
+                                    active &= ~hit;
+                                }
+                                --n;
+                                ++offset;
+                            }
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        if (axis>2)
+                            return; // should not happen
+                        __m128 tl = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(intBitsToFloat(tree[node + 1])), org[axis]), invDir[axis]);
+                        __m128 tr = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(intBitsToFloat(tree[node + 2])), org[axis]), invDir[axis]);
+                        node = offset;
+                        intervalMin = _mm_max_ps(selectLanes(negative[axis], tr, tl), intervalMin);
+                        intervalMax = _mm_min_ps(selectLanes(negative[axis], tl, tr), intervalMax);
+                        if (!(_mm_movemask_ps(_mm_cmple_ps(intervalMin, intervalMax)) & ~done))
+                            break;
+                        continue;
+                    }
+                } // traversal loop
+                do
+                {
+                    // stack is empty?
+                    if (stackPos == 0)
+                        return;
+                    // move back up the stack, hits since the push may have shortened the rays
+                    stackPos--;
+                    intervalMin = stack[stackPos].tnear;
+                    intervalMax = _mm_min_ps(stack[stackPos].tfar, _mm_loadu_ps(maxDist));
+                    if (!(_mm_movemask_ps(_mm_cmple_ps(intervalMin, intervalMax)) & ~done))
+                        continue;
+                    node = stack[stackPos].node;
+                    break;
+                } while (true);
+            }
+        }
+
         bool writeToFile(FILE* wf) const;
         bool readFromFile(FILE* rf);
 
@@ -355,6 +595,12 @@ class BIH
             float tnear;
             float tfar;
         };
+        struct PacketStackNode
+        {
+            uint32 node;
+            __m128 tnear;
+            __m128 tfar;
+        };
 
         class BuildStats
         {
@@ -395,6 +641,7 @@ class BIH
         }
 
         void subdivide(int left, int right, std::vector<uint32> &tempTree, buildData &dat, AABound &gridBox, AABound &nodeBox, int nodeIndex, int depth, BuildStats &stats);
+        void refitNode(uint32 node, const std::vector<AABound> &primBounds, AABound &nodeBound);
 };
 
 #endif // _BIH_H
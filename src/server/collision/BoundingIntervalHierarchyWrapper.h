@@ -24,6 +24,7 @@
 #include "G3D/Set.h"
 #include "BoundingIntervalHierarchy.h"
 
+#define BIH_WRAP_MAX_REFITS     16      // refits of moved objects before the tree is built again
 
 template<class T, class BoundsFunc = BoundsTrait<T> >
 class BIHWrap
@@ -64,9 +65,11 @@ class BIHWrap
     G3D::Table<const T*, uint32> m_obj2Idx;
     G3D::Set<const T*> m_objects_to_push;
     int unbalanced_times;
+    int moved_times;
+    int refit_times;
 
 public:
-    BIHWrap() : unbalanced_times(0) { }
+    BIHWrap() : unbalanced_times(0), moved_times(0), refit_times(0) { }
 
     void insert(const T& obj)
     {
@@ -85,12 +88,33 @@ public:
             m_objects_to_push.remove(&obj);
     }
 
+    // the bounds of obj changed, it stays in the tree
+    void relocate(const T& obj)
+    {
+        if (m_objects_to_push.contains(&obj))
+            ++moved_times;
+    }
+
     void balance()
     {
         if (unbalanced_times == 0)
-            return;
+        {
+            if (moved_times == 0)
+                return;
+
+            // same objects as the last build, only their bounds changed
+            if (refit_times < BIH_WRAP_MAX_REFITS)
+            {
+                moved_times = 0;
+                ++refit_times;
+                m_tree.refit(m_objects, BoundsFunc::getBounds2);
+                return;
+            }
+        }
 
         unbalanced_times = 0;
+        moved_times = 0;
+        refit_times = 0;
         m_objects.fastClear();
         m_obj2Idx.getKeys(m_objects);
         m_objects_to_push.getMembers(m_objects);
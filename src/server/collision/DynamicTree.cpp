@@ -83,6 +83,12 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
         ++unbalanced_times;
     }
 
+    void relocate(const Model& mdl)
+    {
+        base::relocate(mdl);
+        ++unbalanced_times;
+    }
+
     void balance()
     {
         base::balance();
@@ -124,6 +130,11 @@ void DynamicMapTree::remove(const GameObjectModel& mdl)
     impl->remove(mdl);
 }
 
+void DynamicMapTree::relocate(const GameObjectModel& mdl)
+{
+    impl->relocate(mdl);
+}
+
 bool DynamicMapTree::contains(const GameObjectModel& mdl) const
 {
     return impl->contains(mdl);
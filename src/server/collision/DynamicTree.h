@@ -54,6 +54,8 @@ public:
 
     void insert(const GameObjectModel&);
     void remove(const GameObjectModel&);
+    // the model was moved with GameObjectModel::Relocate
+    void relocate(const GameObjectModel&);
     bool contains(const GameObjectModel&) const;
     int size() const;
 
@@ -19,6 +19,7 @@
 #include "MMapManager.h"
 #include "Log.h"
 #include "World.h"
+#include <boost/interprocess/file_mapping.hpp>
 
 namespace MMAP
 {
@@ -76,7 +77,7 @@ namespace MMAP
         TC_LOG_DEBUG("maps", "MMAP:loadMapData: Loaded %03i.mmap", mapId);
 
         // store inside our map list
-        MMapData* mmap_data = new MMapData(mesh);
+        MMapData* mmap_data = new MMapData(mesh, workerCount);
         mmap_data->mmapLoadedTiles.clear();
 
         loadedMMaps.insert(std::pair<uint32, MMapData*>(mapId, mmap_data));
@@ -90,6 +91,8 @@ namespace MMAP
 
     bool MMapManager::loadMap(const std::string& /*basePath*/, uint32 mapId, int32 x, int32 y)
     {
+        boost::unique_lock<boost::shared_mutex> lock(meshLock);
+
         // make sure the mmap is loaded and ready to load tiles
         if (!loadMapData(mapId))
             return false;
@@ -109,8 +112,15 @@ namespace MMAP
 
         snprintf(fileName, pathLen, (sWorld->GetDataPath()+"mmaps/%03i%02i%02i.mmtile").c_str(), mapId, x, y);
 
-        FILE* file = fopen(fileName, "rb");
-        if (!file)
+        // the file is mapped copy on write: detour links the polygons of the tile in place, these pages become private
+        // while vertices, detail meshes and the BV tree stay in the page cache, paged in when first read
+        boost::interprocess::mapped_region* tileFile = NULL;
+        try
+        {
+            boost::interprocess::file_mapping mapping(fileName, boost::interprocess::read_only);
+            tileFile = new boost::interprocess::mapped_region(mapping, boost::interprocess::copy_on_write);
+        }
+        catch (boost::interprocess::interprocess_exception const&)
         {
             TC_LOG_DEBUG("maps", "MMAP:loadMap: Could not open mmtile file '%s'", fileName);
             delete [] fileName;
@@ -119,50 +129,48 @@ namespace MMAP
         delete [] fileName;
 
         // read header
-        MmapTileHeader fileHeader;
-        if (fread(&fileHeader, sizeof(MmapTileHeader), 1, file) != 1 || fileHeader.mmapMagic != MMAP_MAGIC)
+        MmapTileHeader const* fileHeader = (MmapTileHeader const*)tileFile->get_address();
+        if (tileFile->get_size() < sizeof(MmapTileHeader) || fileHeader->mmapMagic != MMAP_MAGIC)
         {
             TC_LOG_ERROR("maps", "MMAP:loadMap: Bad header in mmap %03u%02i%02i.mmtile", mapId, x, y);
-            fclose(file);
+            delete tileFile;
             return false;
         }
 
-        if (fileHeader.mmapVersion != MMAP_VERSION)
+        if (fileHeader->mmapVersion != MMAP_VERSION)
         {
             TC_LOG_ERROR("maps", "MMAP:loadMap: %03u%02i%02i.mmtile was built with generator v%i, expected v%i",
-                mapId, x, y, fileHeader.mmapVersion, MMAP_VERSION);
-            fclose(file);
+                mapId, x, y, fileHeader->mmapVersion, MMAP_VERSION);
+            delete tileFile;
             return false;
         }
 
-        unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
-        ASSERT(data);
-
-        size_t result = fread(data, fileHeader.size, 1, file);
-        if (!result)
+        if (tileFile->get_size() < sizeof(MmapTileHeader) + fileHeader->size)
         {
             TC_LOG_ERROR("maps", "MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
-            fclose(file);
+            delete tileFile;
             return false;
         }
 
-        fclose(file);
-
+        unsigned char* data = (unsigned char*)tileFile->get_address() + sizeof(MmapTileHeader);
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
-        // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
+        // the mapped file stays owned by us, detour must not free the tile data
+        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader->size, 0, 0, &tileRef)))
         {
             mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+            mmap->mmapTileFiles.insert(std::pair<uint32, boost::interprocess::mapped_region*>(packedGridPos, tileFile));
+            mmap->pathCache.Clear();
             ++loadedTiles;
+            mappedTilesSize += tileFile->get_size();
             TC_LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile %03i[%02i, %02i] into %03i[%02i, %02i]", mapId, x, y, mapId, header->x, header->y);
             return true;
         }
         else
         {
             TC_LOG_ERROR("maps", "MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh", mapId, x, y);
-            dtFree(data);
+            delete tileFile;
             return false;
         }
 
@@ -171,6 +179,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
     {
+        boost::unique_lock<boost::shared_mutex> lock(meshLock);
+
         // check if we have this map loaded
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
         {
@@ -204,7 +214,14 @@ namespace MMAP
         else
         {
             mmap->mmapLoadedTiles.erase(packedGridPos);
+            mmap->pathCache.Clear();
             --loadedTiles;
+
+            MMapTileFileSet::iterator tileFile = mmap->mmapTileFiles.find(packedGridPos);
+            mappedTilesSize -= tileFile->second->get_size();
+            delete tileFile->second;
+            mmap->mmapTileFiles.erase(tileFile);
+
             TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile %03i[%02i, %02i] from %03i", mapId, x, y, mapId);
             return true;
         }
@@ -214,6 +231,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId)
     {
+        boost::unique_lock<boost::shared_mutex> lock(meshLock);
+
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
         {
             // file may not exist, therefore not loaded
@@ -232,6 +251,7 @@ namespace MMAP
             else
             {
                 --loadedTiles;
+                mappedTilesSize -= mmap->mmapTileFiles[i->first]->get_size();
                 TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile %03i[%02i, %02i] from %03i", mapId, x, y, mapId);
             }
         }
@@ -301,4 +321,39 @@ namespace MMAP
 
         return mmap->navMeshQueries[instanceId];
     }
+
+    PathCache* MMapManager::GetPathCache(uint32 mapId)
+    {
+        MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
+            return NULL;
+
+        return &itr->second->pathCache;
+    }
+
+    dtNavMeshQuery const* MMapManager::GetWorkerNavMeshQuery(uint32 mapId, uint32 workerId)
+    {
+        MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end() || workerId >= itr->second->workerQueries.size())
+            return NULL;
+
+        // every worker has its own slot, no other thread writes it
+        MMapData* mmap = itr->second;
+        if (!mmap->workerQueries[workerId])
+        {
+            dtNavMeshQuery* query = dtAllocNavMeshQuery();
+            ASSERT(query);
+            if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+            {
+                dtFreeNavMeshQuery(query);
+                TC_LOG_ERROR("maps", "MMAP:GetWorkerNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u worker %u", mapId, workerId);
+                return NULL;
+            }
+
+            TC_LOG_DEBUG("maps", "MMAP:GetWorkerNavMeshQuery: created dtNavMeshQuery for mapId %03u worker %u", mapId, workerId);
+            mmap->workerQueries[workerId] = query;
+        }
+
+        return mmap->workerQueries[workerId];
+    }
 }
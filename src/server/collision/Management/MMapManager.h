@@ -23,33 +23,50 @@
 #include "DetourAlloc.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include "MMapPathCache.h"
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
 
 //  move map related classes
 namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
+    typedef std::unordered_map<uint32, boost::interprocess::mapped_region*> MMapTileFileSet;
     typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
 
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
+        MMapData(dtNavMesh* mesh, uint32 workerCount) : navMesh(mesh), workerQueries(workerCount, NULL) { }
         ~MMapData()
         {
             for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
                 dtFreeNavMeshQuery(i->second);
 
+            for (std::vector<dtNavMeshQuery*>::iterator i = workerQueries.begin(); i != workerQueries.end(); ++i)
+                if (*i)
+                    dtFreeNavMeshQuery(*i);
+
             if (navMesh)
                 dtFreeNavMesh(navMesh);
+
+            // tile data is not owned by the navmesh
+            for (MMapTileFileSet::iterator i = mmapTileFiles.begin(); i != mmapTileFiles.end(); ++i)
+                delete i->second;
         }
 
         dtNavMesh* navMesh;
 
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
+        std::vector<dtNavMeshQuery*> workerQueries; // pathfinding worker to query, created on first use
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+        MMapTileFileSet mmapTileFiles;      // maps [map grid coords] to the mapped .mmtile the tile data is in
+        PathCache pathCache;                // shared by all instances, cleared when tiles change
     };
 
 
@@ -60,7 +77,7 @@ namespace MMAP
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0) { }
+            MMapManager() : loadedTiles(0), mappedTilesSize(0), workerCount(0) { }
             ~MMapManager();
 
             bool loadMap(const std::string& basePath, uint32 mapId, int32 x, int32 y);
@@ -72,7 +89,20 @@ namespace MMAP
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
+            // number of pathfinding worker threads, must be set before any map is loaded
+            void setWorkerCount(uint32 count) { workerCount = count; }
+
+            // query of a pathfinding worker thread, only to be used by that worker while it holds GetMeshLock() shared
+            dtNavMeshQuery const* GetWorkerNavMeshQuery(uint32 mapId, uint32 workerId);
+
+            // thread safe, lives as long as the navmesh of the map
+            PathCache* GetPathCache(uint32 mapId);
+
+            // held unique while the navmeshes change, so worker threads never see a tile being added or removed
+            boost::shared_mutex& GetMeshLock() { return meshLock; }
+
             uint32 getLoadedTilesCount() const { return loadedTiles; }
+            uint64 getMappedTilesSize() const { return mappedTilesSize; }
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
         private:
             bool loadMapData(uint32 mapId);
@@ -80,6 +110,9 @@ namespace MMAP
 
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
+            uint64 mappedTilesSize;             // bytes of .mmtile files mapped, only what is read is paged in
+            uint32 workerCount;
+            boost::shared_mutex meshLock;
     };
 }
 
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MMapPathCache.h"
+#include <algorithm>
+
+namespace MMAP
+{
+    bool PathCache::Find(dtPolyRef startRef, dtPolyRef endRef, uint32 filter, dtPolyRef* path, uint32& pathSize, uint32 maxPathSize)
+    {
+        Key key;
+        key.EndRef = endRef;
+        key.Filter = filter;
+
+        std::lock_guard<std::mutex> lock(_lock);
+
+        auto itr = _paths.find(key);
+        if (itr != _paths.end())
+        {
+            for (uint32 i = 0; i < MMAP_PATH_CACHE_PATHS_PER_END; ++i)
+            {
+                std::vector<dtPolyRef> const& entry = itr->second.Entries[i];
+                std::vector<dtPolyRef>::const_iterator start = std::find(entry.begin(), entry.end(), startRef);
+                if (start == entry.end() || uint32(entry.end() - start) > maxPathSize)
+                    continue;
+
+                pathSize = uint32(entry.end() - start);
+                std::copy(start, entry.end(), path);
+                ++_hits;
+                return true;
+            }
+        }
+
+        ++_misses;
+        return false;
+    }
+
+    void PathCache::Insert(dtPolyRef const* path, uint32 pathSize, uint32 filter)
+    {
+        if (!pathSize)
+            return;
+
+        Key key;
+        key.EndRef = path[pathSize - 1];
+        key.Filter = filter;
+
+        std::lock_guard<std::mutex> lock(_lock);
+
+        if (_paths.size() >= MMAP_PATH_CACHE_MAX_ENDS && _paths.find(key) == _paths.end())
+            _paths.clear();
+
+        Paths& paths = _paths[key];
+        paths.Entries[paths.Next].assign(path, path + pathSize);
+        paths.Next = (paths.Next + 1) % MMAP_PATH_CACHE_PATHS_PER_END;
+    }
+
+    void PathCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _paths.clear();
+    }
+
+    PathCacheStats PathCache::GetStats() const
+    {
+        PathCacheStats stats;
+        stats.Hits = _hits;
+        stats.Misses = _misses;
+        return stats;
+    }
+}
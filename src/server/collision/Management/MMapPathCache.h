@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MMAP_PATH_CACHE_H
+#define _MMAP_PATH_CACHE_H
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace MMAP
+{
+    #define MMAP_PATH_CACHE_PATHS_PER_END   8       // most recent paths kept per end polygon
+    #define MMAP_PATH_CACHE_MAX_ENDS        4096    // the whole cache is dropped beyond this
+
+    struct PathCacheStats
+    {
+        uint64 Hits;
+        uint64 Misses;
+    };
+
+    // Complete poly paths found on one navmesh, by end polygon and query filter.
+    // Units chasing the same target end on the same polygon: the part of a cached path
+    // from any polygon on it to its end is reused, so only the first chaser calls findPath.
+    // Sub-paths of a shortest path are shortest paths themselves.
+    // Must be cleared whenever a tile is added or removed, polygon references change then.
+    class PathCache
+    {
+        struct Key
+        {
+            dtPolyRef EndRef;
+            uint32 Filter;
+
+            bool operator==(Key const& right) const { return EndRef == right.EndRef && Filter == right.Filter; }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(Key const& key) const { return std::hash<uint64>()(key.EndRef) ^ (size_t(key.Filter) << 1); }
+        };
+
+        struct Paths
+        {
+            Paths() : Next(0) { }
+
+            std::vector<dtPolyRef> Entries[MMAP_PATH_CACHE_PATHS_PER_END];
+            uint32 Next;                            // entry replaced by the next insert
+        };
+
+        public:
+            PathCache() : _hits(0), _misses(0) { }
+
+            // copies the cached path from startRef to endRef into path, false if there is none
+            bool Find(dtPolyRef startRef, dtPolyRef endRef, uint32 filter, dtPolyRef* path, uint32& pathSize, uint32 maxPathSize);
+            // path must end at the end polygon the query asked for
+            void Insert(dtPolyRef const* path, uint32 pathSize, uint32 filter);
+            void Clear();
+
+            PathCacheStats GetStats() const;
+
+        private:
+            std::mutex _lock;
+            std::unordered_map<Key, Paths, KeyHash> _paths;
+
+            std::atomic<uint64> _hits;
+            std::atomic<uint64> _misses;
+    };
+}
+
+#endif
@@ -33,7 +33,7 @@ using G3D::Vector3;
 
 namespace VMAP
 {
-    VMapManager2::VMapManager2()
+    VMapManager2::VMapManager2() : iRecordLineOfSight(false), iRecordLineOfSightLimit(0)
     {
         GetLiquidFlagsPtr = &GetLiquidFlagsDummy;
         IsVMAPDisabledForPtr = &IsVMAPDisabledForDummy;
@@ -135,6 +135,9 @@ namespace VMAP
 
     bool VMapManager2::isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2)
     {
+        if (iRecordLineOfSight)
+            recordLineOfSight(mapId, x1, y1, z1, x2, y2, z2);
+
         if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
             return true;
 
@@ -152,6 +155,92 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, float x, float y, float z, Vector3 const* targets, uint32 count, bool* results)
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            results[i] = true;
+            if (iRecordLineOfSight)
+                recordLineOfSight(mapId, x, y, z, targets[i].x, targets[i].y, targets[i].z);
+        }
+
+        if (!count || !isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+            return;
+
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        std::vector<Vector3> internalTargets(count);
+        for (uint32 i = 0; i < count; ++i)
+            internalTargets[i] = convertPositionToInternalRep(targets[i].x, targets[i].y, targets[i].z);
+
+        instanceTree->second->isInLineOfSight(convertPositionToInternalRep(x, y, z), internalTargets.data(), count, results);
+    }
+
+    void VMapManager2::isInLineOfSight(LineOfSightQuery const* queries, uint32 count, bool* results)
+    {
+        std::vector<Vector3> sources;
+        std::vector<Vector3> targets;
+        for (uint32 first = 0, last; first < count; first = last)
+        {
+            uint32 mapId = queries[first].MapId;
+            for (last = first; last < count && queries[last].MapId == mapId; ++last)
+                results[last] = true;
+
+            if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+                continue;
+
+            InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
+            if (instanceTree == iInstanceMapTrees.end())
+                continue;
+
+            sources.clear();
+            targets.clear();
+            for (uint32 i = first; i < last; ++i)
+            {
+                sources.push_back(convertPositionToInternalRep(queries[i].Start.x, queries[i].Start.y, queries[i].Start.z));
+                targets.push_back(convertPositionToInternalRep(queries[i].End.x, queries[i].End.y, queries[i].End.z));
+            }
+
+            instanceTree->second->isInLineOfSight(sources.data(), targets.data(), last - first, results + first);
+        }
+    }
+
+    void VMapManager2::startLineOfSightRecording(uint32 maxQueries)
+    {
+        std::lock_guard<std::mutex> lock(iRecordedLineOfSightLock);
+        iRecordedLineOfSight.clear();
+        iRecordLineOfSightLimit = maxQueries;
+        iRecordLineOfSight = true;
+    }
+
+    void VMapManager2::stopLineOfSightRecording(std::vector<LineOfSightQuery>& queries)
+    {
+        std::lock_guard<std::mutex> lock(iRecordedLineOfSightLock);
+        iRecordLineOfSight = false;
+        iRecordLineOfSightLimit = 0;
+        queries.swap(iRecordedLineOfSight);
+        iRecordedLineOfSight.clear();
+    }
+
+    void VMapManager2::recordLineOfSight(uint32 mapId, float x1, float y1, float z1, float x2, float y2, float z2)
+    {
+        // map threads query at the same time
+        std::lock_guard<std::mutex> lock(iRecordedLineOfSightLock);
+        if (iRecordedLineOfSight.size() >= iRecordLineOfSightLimit)
+        {
+            iRecordLineOfSight = false;
+            return;
+        }
+
+        LineOfSightQuery query;
+        query.MapId = mapId;
+        query.Start = Vector3(x1, y1, z1);
+        query.End = Vector3(x2, y2, z2);
+        iRecordedLineOfSight.push_back(query);
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -19,10 +19,13 @@
 #ifndef _VMAPMANAGER2_H
 #define _VMAPMANAGER2_H
 
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 #include "Define.h"
 #include "IVMapManager.h"
+#include <G3D/Vector3.h>
 
 //===========================================================
 
@@ -40,11 +43,6 @@ Additionally a table to match map ids and map names is used.
 
 //===========================================================
 
-namespace G3D
-{
-    class Vector3;
-}
-
 namespace VMAP
 {
     class StaticMapTree;
@@ -66,6 +64,14 @@ namespace VMAP
     typedef std::unordered_map<uint32, StaticMapTree*> InstanceTreeMap;
     typedef std::unordered_map<std::string, ManagedModel> ModelFileMap;
 
+    // A line of sight query in world coordinates, as recorded for replays
+    struct LineOfSightQuery
+    {
+        uint32 MapId;
+        G3D::Vector3 Start;
+        G3D::Vector3 End;
+    };
+
     enum DisableTypes
     {
         VMAP_DISABLE_AREAFLAG       = 0x1,
@@ -86,6 +92,14 @@ namespace VMAP
             bool _loadMap(uint32 mapId, const std::string& basePath, uint32 tileX, uint32 tileY);
             /* void _unloadMap(uint32 pMapId, uint32 x, uint32 y); */
 
+            void recordLineOfSight(uint32 mapId, float x1, float y1, float z1, float x2, float y2, float z2);
+
+            // Line of sight queries of all maps, only kept while recording
+            std::atomic<bool> iRecordLineOfSight;
+            uint32 iRecordLineOfSightLimit;
+            std::vector<LineOfSightQuery> iRecordedLineOfSight;
+            std::mutex iRecordedLineOfSightLock;
+
             static uint32 GetLiquidFlagsDummy(uint32) { return 0; }
             static bool IsVMAPDisabledForDummy(uint32 /*entry*/, uint8 /*flags*/) { return false; }
 
@@ -103,6 +117,15 @@ namespace VMAP
             void unloadMap(unsigned int mapId) override;
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2) override ;
+            void isInLineOfSight(unsigned int mapId, float x, float y, float z, G3D::Vector3 const* targets, uint32 count, bool* results) override;
+            // Answers the queries in packets of consecutive queries of the same map, for comparison with replaying them one by one
+            void isInLineOfSight(LineOfSightQuery const* queries, uint32 count, bool* results);
+
+            // Records the next maxQueries line of sight queries, an earlier recording is dropped
+            void startLineOfSightRecording(uint32 maxQueries);
+            // Stops recording and hands out what was recorded
+            void stopLineOfSightRecording(std::vector<LineOfSightQuery>& queries);
+            bool isRecordingLineOfSight() const { return iRecordLineOfSight; }
             /**
             fill the hit pos and return true, if an object was hit
             */
@@ -50,6 +50,23 @@ namespace VMAP
         bool hit;
     };
 
+    class MapRayPacketCallback
+    {
+        public:
+            MapRayPacketCallback(ModelInstance* val, const RayPacket& packet): prims(val), packet(packet), hits(0) { }
+            uint32 operator()(uint32 entry, float* distances, uint32 mask, bool pStopAtFirstHit)
+            {
+                uint32 result = prims[entry].intersectRayPacket(packet, distances, mask, pStopAtFirstHit);
+                hits |= result;
+                return result;
+            }
+        uint32 didHit() const { return hits; }
+    protected:
+        ModelInstance* prims;
+        const RayPacket& packet;
+        uint32 hits;
+    };
+
     class AreaInfoCallback
     {
         public:
@@ -173,6 +190,58 @@ namespace VMAP
         return true;
     }
     //=========================================================
+
+    void StaticMapTree::isInLineOfSight(const Vector3& source, const Vector3* targets, uint32 count, bool* results) const
+    {
+        std::vector<Vector3> sources(count, source);
+        isInLineOfSight(sources.data(), targets, count, results);
+    }
+
+    void StaticMapTree::isInLineOfSight(const Vector3* sources, const Vector3* targets, uint32 count, bool* results) const
+    {
+        // the lines traverse the tree together, BIH_PACKET_SIZE at a time
+        for (uint32 first = 0; first < count; first += BIH_PACKET_SIZE)
+        {
+            uint32 n = std::min<uint32>(count - first, BIH_PACKET_SIZE);
+            G3D::Ray rays[BIH_PACKET_SIZE];
+            float maxDist[BIH_PACKET_SIZE] = { };
+            uint32 mask = 0;
+
+            for (uint32 lane = 0; lane < n; ++lane)
+            {
+                results[first + lane] = true;
+
+                // same checks as for a single line
+                Vector3 const& source = sources[first + lane];
+                Vector3 const& target = targets[first + lane];
+                float dist = (target - source).magnitude();
+                if (dist == std::numeric_limits<float>::max() || !std::isfinite(dist))
+                {
+                    results[first + lane] = false;
+                    continue;
+                }
+
+                if (dist < 1e-10f)
+                    continue;
+
+                rays[lane] = G3D::Ray::fromOriginAndDirection(source, (target - source) / dist);
+                maxDist[lane] = dist;
+                mask |= 1 << lane;
+            }
+
+            if (!mask)
+                continue;
+
+            RayPacket packet(rays, n);
+            MapRayPacketCallback intersectionCallBack(iTreeValues, packet);
+            iTree.intersectRayPacket(packet, intersectionCallBack, maxDist, mask, true);
+
+            for (uint32 lane = 0; lane < n; ++lane)
+                if (intersectionCallBack.didHit() & (1 << lane))
+                    results[first + lane] = false;
+        }
+    }
+    //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
     Return the hit pos or the original dest pos
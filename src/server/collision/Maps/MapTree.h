@@ -69,6 +69,10 @@ namespace VMAP
             ~StaticMapTree();
 
             bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2) const;
+            // results[i] for the line from source to targets[i], the tree is traversed once for all of them
+            void isInLineOfSight(const G3D::Vector3& source, const G3D::Vector3* targets, uint32 count, bool* results) const;
+            // results[i] for the line from sources[i] to targets[i], BIH_PACKET_SIZE lines traverse the tree together
+            void isInLineOfSight(const G3D::Vector3* sources, const G3D::Vector3* targets, uint32 count, bool* results) const;
             bool getObjectHitPos(const G3D::Vector3& pos1, const G3D::Vector3& pos2, G3D::Vector3& pResultHitPos, float pModifyDist) const;
             float getHeight(const G3D::Vector3& pPos, float maxSearchDist) const;
             bool getAreaInfo(G3D::Vector3 &pos, uint32 &flags, int32 &adtId, int32 &rootId, int32 &groupId) const;
@@ -64,6 +64,35 @@ namespace VMAP
         return hit;
     }
 
+    uint32 ModelInstance::intersectRayPacket(const RayPacket& packet, float* pMaxDist, uint32 mask, bool pStopAtFirstHit) const
+    {
+        if (!iModel)
+            return 0;
+
+        // same as intersectRay for each ray, child bounds are defined in object space
+        Ray modRays[BIH_PACKET_SIZE];
+        float distance[BIH_PACKET_SIZE];
+        for (uint32 lane = 0; lane < BIH_PACKET_SIZE; ++lane)
+        {
+            const Ray& ray = packet.rays[lane];
+            if ((mask & (1 << lane)) && ray.intersectionTime(iBound) == G3D::finf())
+                mask &= ~(1 << lane);
+
+            modRays[lane] = Ray(iInvRot * (ray.origin() - iPos) * iInvScale, iInvRot * ray.direction());
+            distance[lane] = pMaxDist[lane] * iInvScale;
+        }
+
+        if (!mask)
+            return 0;
+
+        uint32 hits = iModel->IntersectRayPacket(RayPacket(modRays, packet.count), distance, mask, pStopAtFirstHit);
+        for (uint32 lane = 0; lane < BIH_PACKET_SIZE; ++lane)
+            if (hits & (1 << lane))
+                pMaxDist[lane] = distance[lane] * iScale;
+
+        return hits;
+    }
+
     void ModelInstance::intersectPoint(const G3D::Vector3& p, AreaInfo &info) const
     {
         if (!iModel)
@@ -26,6 +26,8 @@
 
 #include "Define.h"
 
+struct RayPacket;
+
 namespace VMAP
 {
     class WorldModel;
@@ -67,6 +69,7 @@ namespace VMAP
             ModelInstance(const ModelSpawn &spawn, WorldModel* model);
             void setUnloaded() { iModel = nullptr; }
             bool intersectRay(const G3D::Ray& pRay, float& pMaxDist, bool pStopAtFirstHit) const;
+            uint32 intersectRayPacket(const RayPacket& packet, float* pMaxDist, uint32 mask, bool pStopAtFirstHit) const;
             void intersectPoint(const G3D::Vector3& p, AreaInfo &info) const;
             bool GetLocationInfo(const G3D::Vector3& p, LocationInfo &info) const;
             bool GetLiquidLevel(const G3D::Vector3& p, LocationInfo &info, float &liqHeight) const;
@@ -80,6 +80,67 @@ namespace VMAP
         return false;
     }
 
+    // IntersectTriangle for the rays of the packet in mask at once, returns the lanes with a new closer hit
+    uint32 IntersectTrianglePacket(const MeshTriangle &tri, std::vector<Vector3>::const_iterator points, const RayPacket &packet, float* distance, uint32 mask)
+    {
+        static const float EPS = 1e-5f;
+
+        const Vector3 e1 = points[tri.idx1] - points[tri.idx0];
+        const Vector3 e2 = points[tri.idx2] - points[tri.idx0];
+        const Vector3& p0 = points[tri.idx0];
+
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 dx = _mm_loadu_ps(packet.dir[0]);
+        const __m128 dy = _mm_loadu_ps(packet.dir[1]);
+        const __m128 dz = _mm_loadu_ps(packet.dir[2]);
+
+        // p = direction x e2
+        const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, _mm_set1_ps(e2.z)), _mm_mul_ps(dz, _mm_set1_ps(e2.y)));
+        const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, _mm_set1_ps(e2.x)), _mm_mul_ps(dx, _mm_set1_ps(e2.z)));
+        const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, _mm_set1_ps(e2.y)), _mm_mul_ps(dy, _mm_set1_ps(e2.x)));
+        const __m128 a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(e1.x), px), _mm_mul_ps(_mm_set1_ps(e1.y), py)), _mm_mul_ps(_mm_set1_ps(e1.z), pz));
+
+        // determinant is ill-conditioned
+        __m128 valid = _mm_cmpge_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), a), _mm_set1_ps(EPS));
+        if (!(_mm_movemask_ps(valid) & mask))
+            return 0;
+
+        const __m128 f = _mm_div_ps(one, a);
+        const __m128 sx = _mm_sub_ps(_mm_loadu_ps(packet.org[0]), _mm_set1_ps(p0.x));
+        const __m128 sy = _mm_sub_ps(_mm_loadu_ps(packet.org[1]), _mm_set1_ps(p0.y));
+        const __m128 sz = _mm_sub_ps(_mm_loadu_ps(packet.org[2]), _mm_set1_ps(p0.z));
+        const __m128 u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)));
+
+        // plane hit outside the triangle
+        valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+
+        // q = s x e1
+        const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, _mm_set1_ps(e1.z)), _mm_mul_ps(sz, _mm_set1_ps(e1.y)));
+        const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, _mm_set1_ps(e1.x)), _mm_mul_ps(sx, _mm_set1_ps(e1.z)));
+        const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, _mm_set1_ps(e1.y)), _mm_mul_ps(sy, _mm_set1_ps(e1.x)));
+        const __m128 v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)));
+
+        valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+
+        const __m128 t = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(e2.x), qx), _mm_mul_ps(_mm_set1_ps(e2.y), qy)), _mm_mul_ps(_mm_set1_ps(e2.z), qz)));
+
+        // only hits closer than the previous ones
+        valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpgt_ps(t, zero), _mm_cmplt_ps(t, _mm_loadu_ps(distance))));
+
+        uint32 hits = _mm_movemask_ps(valid) & mask;
+        if (hits)
+        {
+            float time[BIH_PACKET_SIZE];
+            _mm_storeu_ps(time, t);
+            for (uint32 lane = 0; lane < BIH_PACKET_SIZE; ++lane)
+                if (hits & (1 << lane))
+                    distance[lane] = time[lane];
+        }
+
+        return hits;
+    }
+
     class TriBoundFunc
     {
         public:
@@ -381,6 +442,32 @@ namespace VMAP
         return callback.hit;
     }
 
+    struct GModelRayPacketCallback
+    {
+        GModelRayPacketCallback(const std::vector<MeshTriangle> &tris, const std::vector<Vector3> &vert, const RayPacket &packet):
+            vertices(vert.begin()), triangles(tris.begin()), packet(packet), hits(0) { }
+        uint32 operator()(uint32 entry, float* distances, uint32 mask, bool /*pStopAtFirstHit*/)
+        {
+            uint32 result = IntersectTrianglePacket(triangles[entry], vertices, packet, distances, mask);
+            hits |= result;
+            return result;
+        }
+        std::vector<Vector3>::const_iterator vertices;
+        std::vector<MeshTriangle>::const_iterator triangles;
+        const RayPacket &packet;
+        uint32 hits;
+    };
+
+    uint32 GroupModel::IntersectRayPacket(const RayPacket &packet, float* distances, uint32 mask, bool stopAtFirstHit) const
+    {
+        if (triangles.empty())
+            return 0;
+
+        GModelRayPacketCallback callback(triangles, vertices, packet);
+        meshTree.intersectRayPacket(packet, callback, distances, mask, stopAtFirstHit);
+        return callback.hits;
+    }
+
     bool GroupModel::IsInsideObject(const Vector3 &pos, const Vector3 &down, float &z_dist) const
     {
         if (triangles.empty() || !iBound.contains(pos))
@@ -442,6 +529,31 @@ namespace VMAP
         return isc.hit;
     }
 
+    struct WModelRayPacketCallback
+    {
+        WModelRayPacketCallback(const std::vector<GroupModel> &mod, const RayPacket &packet): models(mod.begin()), packet(packet), hits(0) { }
+        uint32 operator()(uint32 entry, float* distances, uint32 mask, bool pStopAtFirstHit)
+        {
+            uint32 result = models[entry].IntersectRayPacket(packet, distances, mask, pStopAtFirstHit);
+            hits |= result;
+            return result;
+        }
+        std::vector<GroupModel>::const_iterator models;
+        const RayPacket &packet;
+        uint32 hits;
+    };
+
+    uint32 WorldModel::IntersectRayPacket(const RayPacket &packet, float* distances, uint32 mask, bool stopAtFirstHit) const
+    {
+        // same M2 workaround as IntersectRay
+        if (groupModels.size() == 1)
+            return groupModels[0].IntersectRayPacket(packet, distances, mask, stopAtFirstHit);
+
+        WModelRayPacketCallback isc(groupModels, packet);
+        groupTree.intersectRayPacket(packet, isc, distances, mask, stopAtFirstHit);
+        return isc.hits;
+    }
+
     class WModelAreaCallback {
         public:
             WModelAreaCallback(const std::vector<GroupModel> &vals, const Vector3 &down):
@@ -62,6 +62,24 @@ public:
         memberTable.remove(&value);
     }
 
+    // value moved, a move inside its cell only updates the bounds in the cell's tree
+    void relocate(const T& value)
+    {
+        G3D::Vector3 pos;
+        PositionFunc::getPosition(value, pos);
+        Node& node = getGridFor(pos.x, pos.y);
+        Node*& oldNode = memberTable[&value];
+        if (oldNode == &node)
+        {
+            node.relocate(value);
+            return;
+        }
+
+        oldNode->remove(value);
+        node.insert(value);
+        oldNode = &node;
+    }
+
     void balance()
     {
         for (int x = 0; x < CELL_NUMBER; ++x)
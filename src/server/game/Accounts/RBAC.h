@@ -696,6 +696,8 @@ enum RBACPermissions
     RBAC_PERM_COMMAND_MODIFY_XP                              = 798,
 
     // custom permissions 1000+
+    RBAC_PERM_COMMAND_SERVER_DBSTATS                         = 1000,
+    RBAC_PERM_COMMAND_DEBUG_COMBAT                           = 1001,
     RBAC_PERM_MAX
 };
 
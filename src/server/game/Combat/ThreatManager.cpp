@@ -97,6 +97,8 @@ HostileReference::HostileReference(Unit* refUnit, ThreatManager* threatManager,
     iUnitGuid = refUnit->GetGUID();
     iOnline = true;
     iAccessible = true;
+    iContainer = NULL;
+    iReorderPending = false;
 }
 
 //============================================================
@@ -258,6 +260,70 @@ void ThreatContainer::clearReferences()
     }
 
     iThreatList.clear();
+    iThreatIndex.clear();
+    iReferenceByGuid.clear();
+    iReorderPending.clear();
+}
+
+//============================================================
+// New references go to the end of the list like before, the index places them after equal threat
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    hostileRef->iContainer = this;
+    hostileRef->iListPosition = iThreatList.insert(iThreatList.end(), hostileRef);
+    hostileRef->iIndexPosition = iThreatIndex.insert(IndexType::value_type(hostileRef->getThreat(), hostileRef));
+    iReferenceByGuid[hostileRef->getUnitGuid()] = hostileRef;
+
+    hostileRef->iReorderPending = true;
+    iReorderPending.push_back(hostileRef);
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    if (hostileRef->iContainer != this)
+        return;
+
+    iThreatList.erase(hostileRef->iListPosition);
+    iThreatIndex.erase(hostileRef->iIndexPosition);
+
+    std::unordered_map<ObjectGuid, HostileReference*>::iterator itr = iReferenceByGuid.find(hostileRef->getUnitGuid());
+    if (itr != iReferenceByGuid.end() && itr->second == hostileRef)
+        iReferenceByGuid.erase(itr);
+
+    if (hostileRef->iReorderPending)
+    {
+        iReorderPending.erase(std::find(iReorderPending.begin(), iReorderPending.end(), hostileRef));
+        hostileRef->iReorderPending = false;
+    }
+
+    hostileRef->iContainer = NULL;
+}
+
+//============================================================
+// Move the reference in the index, among equal threat it keeps the side it came from like a stable sort
+
+void ThreatContainer::reorderReference(HostileReference* hostileRef)
+{
+    if (hostileRef->iContainer != this)
+        return;
+
+    float oldThreat = hostileRef->iIndexPosition->first;
+    float threat = hostileRef->getThreat();
+    if (threat == oldThreat)
+        return;
+
+    iThreatIndex.erase(hostileRef->iIndexPosition);
+    IndexType::iterator hint = threat < oldThreat ? iThreatIndex.lower_bound(threat) : iThreatIndex.upper_bound(threat);
+    hostileRef->iIndexPosition = iThreatIndex.insert(hint, IndexType::value_type(threat, hostileRef));
+
+    if (!hostileRef->iReorderPending)
+    {
+        hostileRef->iReorderPending = true;
+        iReorderPending.push_back(hostileRef);
+    }
 }
 
 //============================================================
@@ -267,15 +333,11 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim) const
     if (!victim)
         return NULL;
 
-    ObjectGuid guid = victim->GetGUID();
-    for (ThreatContainer::StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        HostileReference* ref = (*i);
-        if (ref && ref->getUnitGuid() == guid)
-            return ref;
-    }
+    std::unordered_map<ObjectGuid, HostileReference*>::const_iterator itr = iReferenceByGuid.find(victim->GetGUID());
+    if (itr == iReferenceByGuid.end())
+        return NULL;
 
-    return NULL;
+    return itr->second;
 }
 
 //============================================================
@@ -302,8 +364,32 @@ void ThreatContainer::modifyThreatPercent(Unit* victim, int32 percent)
 
 void ThreatContainer::update()
 {
-    if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(Trinity::ThreatOrderPred());
+    if (iDirty && !iReorderPending.empty())
+    {
+        if (iReorderPending.size() * iReorderPending.size() > iThreatList.size())
+        {
+            // many changed references, relink the whole list in index order
+            for (IndexType::const_iterator itr = iThreatIndex.begin(); itr != iThreatIndex.end(); ++itr)
+                iThreatList.splice(iThreatList.end(), iThreatList, itr->second->iListPosition);
+
+            for (HostileReference* ref : iReorderPending)
+                ref->iReorderPending = false;
+        }
+        else
+        {
+            // put each changed reference in front of the next one in index order that is already in place
+            for (HostileReference* ref : iReorderPending)
+            {
+                IndexType::const_iterator next = ref->iIndexPosition;
+                while (++next != iThreatIndex.end() && next->second->iReorderPending) { }
+
+                iThreatList.splice(next != iThreatIndex.end() ? next->second->iListPosition : iThreatList.end(), iThreatList, ref->iListPosition);
+                ref->iReorderPending = false;
+            }
+        }
+
+        iReorderPending.clear();
+    }
 
     iDirty = false;
 }
@@ -521,6 +607,8 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
+            iThreatContainer.reorderReference(hostilRef);
+            iThreatOfflineContainer.reorderReference(hostilRef);
             if ((getCurrentVictim() == hostilRef && threatRefStatusChangeEvent->getFValue()<0.0f) ||
                 (getCurrentVictim() != hostilRef && threatRefStatusChangeEvent->getFValue()>0.0f))
                 setDirty(true);                             // the order in the threat list might have changed
@@ -541,8 +629,8 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
             {
                 if (getCurrentVictim() && hostilRef->getThreat() > (1.1f * getCurrentVictim()->getThreat()))
                     setDirty(true);
-                iThreatContainer.addReference(hostilRef);
                 iThreatOfflineContainer.remove(hostilRef);
+                iThreatContainer.addReference(hostilRef);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
@@ -26,12 +26,16 @@
 #include "ObjectGuid.h"
 
 #include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
 
 //==============================================================
 
 class Unit;
 class Creature;
 class ThreatManager;
+class ThreatContainer;
 class SpellInfo;
 
 #define THREAT_UPDATE_INTERVAL 1 * IN_MILLISECONDS    // Server should send threat update to client periodically each second
@@ -48,6 +52,8 @@ struct ThreatCalcHelper
 //==============================================================
 class HostileReference : public Reference<Unit, ThreatManager>
 {
+        friend class ThreatContainer;
+
     public:
         HostileReference(Unit* refUnit, ThreatManager* threatManager, float threat);
 
@@ -136,6 +142,12 @@ class HostileReference : public Reference<Unit, ThreatManager>
         ObjectGuid iUnitGuid;
         bool iOnline;
         bool iAccessible;
+
+        // position in the container holding the reference, maintained by ThreatContainer
+        ThreatContainer* iContainer;
+        std::list<HostileReference*>::iterator iListPosition;
+        std::multimap<float, HostileReference*, std::greater<float> >::iterator iIndexPosition;
+        bool iReorderPending;
 };
 
 //==============================================================
@@ -147,6 +159,7 @@ class ThreatContainer
 
     public:
         typedef std::list<HostileReference*> StorageType;
+        typedef std::multimap<float, HostileReference*, std::greater<float> > IndexType;
 
         ThreatContainer(): iDirty(false) { }
 
@@ -176,23 +189,25 @@ class ThreatContainer
 
         StorageType const & getThreatList() const { return iThreatList; }
 
+        // Bring the list in threat order if it is dirty
+        void update();
+
     private:
-        void remove(HostileReference* hostileRef)
-        {
-            iThreatList.remove(hostileRef);
-        }
+        void remove(HostileReference* hostileRef);
 
-        void addReference(HostileReference* hostileRef)
-        {
-            iThreatList.push_back(hostileRef);
-        }
+        void addReference(HostileReference* hostileRef);
 
-        void clearReferences();
+        // Index the changed threat of the reference, the list follows at the next update
+        void reorderReference(HostileReference* hostileRef);
 
-        // Sort the list if necessary
-        void update();
+        void clearReferences();
 
+        // The list keeps its order between updates, the threat index is always sorted.
+        // At an update only the references with changed threat are moved, no full sort.
         StorageType iThreatList;
+        IndexType iThreatIndex;
+        std::unordered_map<ObjectGuid, HostileReference*> iReferenceByGuid;
+        std::vector<HostileReference*> iReorderPending;
         bool iDirty;
 };
 
@@ -2100,6 +2100,10 @@ void GameObject::EnableCollision(bool enable)
         GetMap()->InsertGameObjectModel(*m_model);*/
 
     m_model->enable(enable ? GetPhaseMask() : 0);
+
+    // doors open and close without leaving the tree
+    if (Map* map = FindMap())
+        map->ClearLineOfSightCache();
 }
 
 void GameObject::UpdateModel()
@@ -2291,8 +2295,7 @@ void GameObject::UpdateModelPosition()
 
     if (GetMap()->ContainsGameObjectModel(*m_model))
     {
-        GetMap()->RemoveGameObjectModel(*m_model);
         m_model->Relocate(*this);
-        GetMap()->InsertGameObjectModel(*m_model);
+        GetMap()->RelocateGameObjectModel(*m_model);
     }
 }
@@ -30,6 +30,7 @@
 #include "CellImpl.h"
 #include "Channel.h"
 #include "ChannelMgr.h"
+#include "CharacterCache.h"
 #include "CharacterDatabaseCleaner.h"
 #include "Chat.h"
 #include "Common.h"
@@ -4679,20 +4680,21 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
     if (accountId == 0)
         updateRealmChars = false;
 
-    // Convert guid to low GUID for CharacterNameData, but also other methods on success
+    // Convert guid to low GUID for the character cache, but also other methods on success
     uint32 guid = playerguid.GetCounter();
     uint32 charDelete_method = sWorld->getIntConfig(CONFIG_CHARDELETE_METHOD);
 
+    CharacterCacheEntry cacheEntry;
     if (deleteFinally)
         charDelete_method = CHAR_DELETE_REMOVE;
-    else if (CharacterNameData const* nameData = sWorld->GetCharacterNameData(playerguid))    // To avoid a query, we select loaded data. If it doesn't exist, return.
+    else if (sCharacterCache->GetCharacterCacheByGuid(playerguid, cacheEntry))    // To avoid a query, we select loaded data. If it doesn't exist, return.
     {
         // Define the required variables
-        uint32 charDelete_minLvl = sWorld->getIntConfig(nameData->m_class != CLASS_DEATH_KNIGHT ? CONFIG_CHARDELETE_MIN_LEVEL : CONFIG_CHARDELETE_HEROIC_MIN_LEVEL);
+        uint32 charDelete_minLvl = sWorld->getIntConfig(cacheEntry.Class != CLASS_DEATH_KNIGHT ? CONFIG_CHARDELETE_MIN_LEVEL : CONFIG_CHARDELETE_HEROIC_MIN_LEVEL);
 
         // if we want to finalize the character removal or the character does not meet the level requirement of either heroic or non-heroic settings,
         // we set it to mode CHAR_DELETE_REMOVE
-        if (nameData->m_level < charDelete_minLvl)
+        if (cacheEntry.Level < charDelete_minLvl)
             charDelete_method = CHAR_DELETE_REMOVE;
     }
 
@@ -5021,7 +5023,7 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
     if (updateRealmChars)
         sWorld->UpdateRealmCharCount(accountId);
 
-    sWorld->DeleteCharacterNameData(playerguid);
+    sCharacterCache->DeleteCharacterCacheEntry(playerguid);
 }
 
 /**
@@ -19581,6 +19583,9 @@ void Player::SaveToDB(bool create /*=false*/)
 
     CharacterDatabase.CommitTransaction(trans);
 
+    // level changes are already pushed to the cache, this only catches anything that bypassed it
+    sCharacterCache->UpdateCharacterLevel(GetGUID(), getLevel());
+
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
         pet->SavePetToDB(PET_SAVE_AS_CURRENT);
@@ -27304,7 +27309,7 @@ void Player::LockCharacter()
 	std::ostringstream newName;
 	newName << GetName() << " (DEAD)";
 	SetName(newName.str());
-	sWorld->UpdateCharacterNameData(GetGUID(), newName.str());
+	sCharacterCache->UpdateCharacterData(GetGUID(), newName.str());
 	sWorld->BanCharacter(GetName(), "-1", "Death", "Player::LockCharacter");
 }
 
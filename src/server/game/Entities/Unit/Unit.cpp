@@ -23,6 +23,7 @@
 #include "Battleground.h"
 #include "BattlegroundScore.h"
 #include "CellImpl.h"
+#include "CharacterCache.h"
 #include "ChatTextBuilder.h"
 #include "ConditionMgr.h"
 #include "CreatureAI.h"
@@ -167,7 +168,7 @@ Unit::Unit(bool isWorldObject) :
     i_AI(NULL), i_disabledAI(NULL), m_AutoRepeatFirstCast(false), m_procDeep(0),
     m_removedAurasCount(0), i_motionMaster(new MotionMaster(this)), m_regenTimer(0), m_ThreatManager(this),
     m_vehicle(NULL), m_vehicleKit(NULL), m_unitTypeMask(UNIT_MASK_NONE),
-    m_HostileRefManager(this), _lastDamagedTime(0)
+    m_splinePositionQueued(false), m_HostileRefManager(this), _lastDamagedTime(0)
 {
     m_objectType |= TYPEMASK_UNIT;
     m_objectTypeId = TYPEID_UNIT;
@@ -198,7 +199,7 @@ Unit::Unit(bool isWorldObject) :
     for (uint8 i = 0; i < MAX_GAMEOBJECT_SLOT; ++i)
         m_ObjectSlot[i].Clear();
 
-    m_auraUpdateIterator = m_ownedAuras.end();
+    m_auraUpdateTime = 0;
 
     m_interruptMask = 0;
     m_transform = 0;
@@ -207,6 +208,14 @@ Unit::Unit(bool isWorldObject) :
     for (uint8 i = 0; i < MAX_SPELL_IMMUNITY; ++i)
         m_spellImmune[i].clear();
 
+    for (uint16 i = 0; i < TOTAL_AURAS; ++i)
+        m_modAurasGeneration[i] = 0;
+
+    m_procIndexSequence = 0;
+
+    m_spellBonusBatchDepth = 0;
+    m_spellBonusGeneration = 0;
+
     for (uint8 i = 0; i < UNIT_MOD_END; ++i)
     {
         m_auraModifiersGroup[i][BASE_VALUE] = 0.0f;
@@ -391,19 +400,42 @@ void Unit::UpdateSplineMovement(uint32 t_diff)
         return;
 
     movespline->updateState(t_diff);
-    bool arrived = movespline->Finalized();
 
-    if (arrived)
+    if (movespline->Finalized())
+    {
+        // movement generators expect the unit at the end of the path right after arrival
         DisableSpline();
+        UpdateSplinePosition();
+        return;
+    }
 
     m_movesplineTimer.Update(t_diff);
-    if (m_movesplineTimer.Passed() || arrived)
-        UpdateSplinePosition();
+    if (m_movesplineTimer.Passed() && !m_splinePositionQueued)
+    {
+        m_splinePositionQueued = true;
+        GetMap()->AddUnitToSplineUpdateList(this);
+    }
 }
 
-void Unit::UpdateSplinePosition()
+void Unit::UpdateQueuedSplinePosition()
+{
+    // left the world earlier in the same pass of the map
+    if (!m_splinePositionQueued || !IsInWorld())
+        return;
+
+    m_splinePositionQueued = false;
+
+    // a new movement could have been launched or stopped since
+    if (!movespline->Finalized())
+        UpdateSplinePosition(true);
+}
+
+void Unit::UpdateSplinePosition(bool skipSmallSteps /*= false*/)
 {
     static uint32 const positionUpdateDelay = 400;
+    // a unit at walk speed (2.5 yd/s) moves 1 yd per delay and is written back every second time, running ones always
+    static float const minRelocationDist = 1.5f;
+    static float const minRelocationAngle = 0.1f;
 
     m_movesplineTimer.Reset(positionUpdateDelay);
     Movement::Location loc = movespline->ComputePosition();
@@ -423,6 +455,11 @@ void Unit::UpdateSplinePosition()
     if (HasUnitState(UNIT_STATE_CANNOT_TURN))
         loc.orientation = GetOrientation();
 
+    // not worth a relocation, the next update or the arrival moves the unit
+    if (skipSmallSteps && GetExactDistSq(loc.x, loc.y, loc.z) < minRelocationDist * minRelocationDist &&
+        std::fabs(GetOrientation() - loc.orientation) < minRelocationAngle)
+        return;
+
     UpdatePosition(loc.x, loc.y, loc.z, loc.orientation);
 }
 
@@ -2915,22 +2952,28 @@ void Unit::_UpdateSpells(uint32 time)
         }
     }
 
-    // m_auraUpdateIterator can be updated in indirect called code at aura remove to skip next planned to update but removed auras
-    for (m_auraUpdateIterator = m_ownedAuras.begin(); m_auraUpdateIterator != m_ownedAuras.end();)
+    m_auraUpdateTime += time;
+
+    // update only auras with a due timer, the others get the elapsed time at their next update
+    // auras removed in indirect called code are unscheduled, auras added are scheduled and can be updated in this loop
+    std::vector<Aura*> updatedAuras;
+    while (!m_auraUpdateQueue.empty() && m_auraUpdateQueue.begin()->first <= m_auraUpdateTime)
     {
-        Aura* i_aura = m_auraUpdateIterator->second;
-        ++m_auraUpdateIterator;                            // need shift to next for allow update if need into aura update
-        i_aura->UpdateOwner(time, this);
+        Aura* i_aura = m_auraUpdateQueue.begin()->second;
+        i_aura->_UnscheduleUpdate();
+        i_aura->UpdateOwner(i_aura->GetPendingUpdateTime(), this);
+        updatedAuras.push_back(i_aura);
+
+        // at most one update per unit update, same as updating all auras every time
+        if (!i_aura->IsRemoved())
+            i_aura->_ScheduleUpdate(1);
     }
 
     // remove expired auras - do that after updates(used in scripts?)
-    for (AuraMap::iterator i = m_ownedAuras.begin(); i != m_ownedAuras.end();)
-    {
-        if (i->second->IsExpired())
-            RemoveOwnedAura(i, AURA_REMOVE_BY_EXPIRE);
-        else
-            ++i;
-    }
+    // an aura can only expire in its update, auras with duration set to 0 are due immediately
+    for (std::vector<Aura*>::const_iterator itr = updatedAuras.begin(); itr != updatedAuras.end(); ++itr)
+        if ((*itr)->IsExpired())
+            RemoveOwnedAura(*itr, AURA_REMOVE_BY_EXPIRE);
 
     for (VisibleAuraMap::iterator itr = m_visibleAuras.begin(); itr != m_visibleAuras.end(); ++itr)
         if (itr->second->IsNeedClientUpdate())
@@ -3304,6 +3347,7 @@ void Unit::_AddAura(UnitAura* aura, Unit* caster)
 {
     ASSERT(!m_cleanupDone);
     m_ownedAuras.insert(AuraMap::value_type(aura->GetId(), aura));
+    aura->_ScheduleUpdate();
 
     _RemoveNoStackAurasDueToAura(aura);
 
@@ -3372,6 +3416,8 @@ AuraApplication * Unit::_CreateAuraApplication(Aura* aura, uint8 effMask)
     if (AuraStateType aState = aura->GetSpellInfo()->GetAuraState())
         m_auraStateAuras.insert(AuraStateAurasMap::value_type(aState, aurApp));
 
+    _RegisterAuraProc(aurApp, true);
+
     aura->_ApplyForTarget(this, caster, aurApp);
     return aurApp;
 }
@@ -3448,6 +3494,8 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMo
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
 
+    _RegisterAuraProc(aurApp, false);
+
     if (aura->GetSpellInfo()->AuraInterruptFlags)
     {
         m_interruptableAuras.remove(aurApp);
@@ -3572,6 +3620,58 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+
+    InvalidateAuraModifierCache(aurEff->GetAuraType());
+}
+
+void Unit::_RegisterAuraProc(AuraApplication* aurApp, bool apply)
+{
+    if (!apply)
+    {
+        // proc data may have been reloaded since the aura was indexed, look in every bucket
+        for (uint8 i = 0; i < MAX_PROC_FLAG_BITS; ++i)
+        {
+            ProcIndexBucket& bucket = m_procIndex[i];
+            for (ProcIndexBucket::iterator itr = bucket.begin(); itr != bucket.end(); ++itr)
+            {
+                if (itr->Application == aurApp)
+                {
+                    bucket.erase(itr);
+                    break;
+                }
+            }
+        }
+        return;
+    }
+
+    SpellInfo const* spellProto = aurApp->GetBase()->GetSpellInfo();
+
+    // handled by the new proc system, never triggered in ProcDamageAndSpellFor
+    if (sSpellMgr->GetSpellProcEntry(spellProto->Id))
+        return;
+
+    // same proc flags as checked by IsTriggeredAtSpellProcEvent
+    uint32 procFlags = spellProto->ProcFlags;
+    if (SpellProcEventEntry const* spellProcEvent = sSpellMgr->GetSpellProcEvent(spellProto->Id))
+        if (spellProcEvent->procFlags)
+            procFlags = spellProcEvent->procFlags;
+
+    if (!procFlags)
+        return;
+
+    ProcIndexEntry entry;
+    entry.SpellId = spellProto->Id;
+    entry.Sequence = m_procIndexSequence++;
+    entry.Application = aurApp;
+
+    for (uint8 i = 0; i < MAX_PROC_FLAG_BITS; ++i)
+    {
+        if (procFlags & (1 << i))
+        {
+            ProcIndexBucket& bucket = m_procIndex[i];
+            bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), entry), entry);
+        }
+    }
 }
 
 // All aura base removes should go threw this function!
@@ -3580,9 +3680,7 @@ void Unit::RemoveOwnedAura(AuraMap::iterator &i, AuraRemoveMode removeMode)
     Aura* aura = i->second;
     ASSERT(!aura->IsRemoved());
 
-    // if unit currently update aura list then make safe update iterator shift to next
-    if (m_auraUpdateIterator == i)
-        ++m_auraUpdateIterator;
+    aura->_UnscheduleUpdate();
 
     m_ownedAuras.erase(i);
     m_removedAuras.push_back(aura);
@@ -4530,12 +4628,30 @@ uint32 Unit::GetDoTsByCaster(ObjectGuid casterGUID) const
     return dots;
 }
 
+bool Unit::GetCachedAuraModifier(AuraType auratype, AuraModifierQuery query, uint32 misc, AuraModifierCacheEntry*& entry) const
+{
+    uint64 key = (uint64(auratype) << 40) | (uint64(query) << 32) | misc;
+    std::pair<AuraModifierCache::iterator, bool> result = m_auraModifierCache.insert(std::make_pair(key, AuraModifierCacheEntry()));
+    entry = &result.first->second;
+
+    uint32 generation = m_modAurasGeneration[auratype];
+    if (!result.second && entry->Generation == generation)
+        return true;
+
+    entry->Generation = generation;
+    return false;
+}
+
 int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     if (mTotalAuraList.empty())
         return 0;
 
+    AuraModifierCacheEntry* entry;
+    if (GetCachedAuraModifier(auratype, AURA_MODIFIER_TOTAL, 0, entry))
+        return entry->Modifier;
+
     std::map<SpellGroup, int32> SameEffectSpellGroup;
     int32 modifier = 0;
 
@@ -4546,53 +4662,84 @@ int32 Unit::GetTotalAuraModifier(AuraType auratype) const
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         modifier += itr->second;
 
+    entry->Modifier = modifier;
     return modifier;
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 1.0f;
+
+    AuraModifierCacheEntry* entry;
+    if (GetCachedAuraModifier(auratype, AURA_MODIFIER_MULTIPLIER, 0, entry))
+        return entry->Multiplier;
+
     float multiplier = 1.0f;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
         AddPct(multiplier, (*i)->GetAmount());
 
+    entry->Multiplier = multiplier;
     return multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    AuraModifierCacheEntry* entry;
+    if (GetCachedAuraModifier(auratype, AURA_MODIFIER_MAX_POSITIVE, 0, entry))
+        return entry->Modifier;
+
     int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if ((*i)->GetAmount() > modifier)
             modifier = (*i)->GetAmount();
     }
 
+    entry->Modifier = modifier;
     return modifier;
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    AuraModifierCacheEntry* entry;
+    if (GetCachedAuraModifier(auratype, AURA_MODIFIER_MAX_NEGATIVE, 0, entry))
+        return entry->Modifier;
+
     int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
         if ((*i)->GetAmount() < modifier)
             modifier = (*i)->GetAmount();
 
+    entry->Modifier = modifier;
     return modifier;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 miscMask) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    AuraModifierCacheEntry* entry;
+    if (GetCachedAuraModifier(auratype, AURA_MODIFIER_TOTAL_BY_MISC_MASK, miscMask, entry))
+        return entry->Modifier;
+
     std::map<SpellGroup, int32> SameEffectSpellGroup;
     int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
         if ((*i)->GetMiscValue() & miscMask)
             if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
@@ -4601,15 +4748,23 @@ int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 miscMask) c
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         modifier += itr->second;
 
+    entry->Modifier = modifier;
     return modifier;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 miscMask) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 1.0f;
+
+    AuraModifierCacheEntry* entry;
+    if (GetCachedAuraModifier(auratype, AURA_MODIFIER_MULTIPLIER_BY_MISC_MASK, miscMask, entry))
+        return entry->Multiplier;
+
     std::map<SpellGroup, int32> SameEffectSpellGroup;
     float multiplier = 1.0f;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if (((*i)->GetMiscValue() & miscMask))
@@ -4624,43 +4779,69 @@ float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 miscMask)
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         AddPct(multiplier, itr->second);
 
+    entry->Multiplier = multiplier;
     return multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 miscMask, const AuraEffect* except) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    // Results excluding a single effect are not worth caching
+    AuraModifierCacheEntry* entry = NULL;
+    if (!except && GetCachedAuraModifier(auratype, AURA_MODIFIER_MAX_POSITIVE_BY_MISC_MASK, miscMask, entry))
+        return entry->Modifier;
+
     int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if (except != (*i) && (*i)->GetMiscValue()& miscMask && (*i)->GetAmount() > modifier)
             modifier = (*i)->GetAmount();
     }
 
+    if (entry)
+        entry->Modifier = modifier;
     return modifier;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 miscMask) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    AuraModifierCacheEntry* entry;
+    if (GetCachedAuraModifier(auratype, AURA_MODIFIER_MAX_NEGATIVE_BY_MISC_MASK, miscMask, entry))
+        return entry->Modifier;
+
     int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if ((*i)->GetMiscValue()& miscMask && (*i)->GetAmount() < modifier)
             modifier = (*i)->GetAmount();
     }
 
+    entry->Modifier = modifier;
     return modifier;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 miscValue) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    AuraModifierCacheEntry* entry;
+    if (GetCachedAuraModifier(auratype, AURA_MODIFIER_TOTAL_BY_MISC_VALUE, uint32(miscValue), entry))
+        return entry->Modifier;
+
     std::map<SpellGroup, int32> SameEffectSpellGroup;
     int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if ((*i)->GetMiscValue() == miscValue)
@@ -4671,15 +4852,23 @@ int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 miscValue)
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         modifier += itr->second;
 
+    entry->Modifier = modifier;
     return modifier;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 miscValue) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 1.0f;
+
+    AuraModifierCacheEntry* entry;
+    if (GetCachedAuraModifier(auratype, AURA_MODIFIER_MULTIPLIER_BY_MISC_VALUE, uint32(miscValue), entry))
+        return entry->Multiplier;
+
     std::map<SpellGroup, int32> SameEffectSpellGroup;
     float multiplier = 1.0f;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if ((*i)->GetMiscValue() == miscValue)
@@ -4690,34 +4879,51 @@ float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 miscValue
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         AddPct(multiplier, itr->second);
 
+    entry->Multiplier = multiplier;
     return multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 miscValue) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    AuraModifierCacheEntry* entry;
+    if (GetCachedAuraModifier(auratype, AURA_MODIFIER_MAX_POSITIVE_BY_MISC_VALUE, uint32(miscValue), entry))
+        return entry->Modifier;
+
     int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if ((*i)->GetMiscValue() == miscValue && (*i)->GetAmount() > modifier)
             modifier = (*i)->GetAmount();
     }
 
+    entry->Modifier = modifier;
     return modifier;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 miscValue) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    AuraModifierCacheEntry* entry;
+    if (GetCachedAuraModifier(auratype, AURA_MODIFIER_MAX_NEGATIVE_BY_MISC_VALUE, uint32(miscValue), entry))
+        return entry->Modifier;
+
     int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if ((*i)->GetMiscValue() == miscValue && (*i)->GetAmount() < modifier)
             modifier = (*i)->GetAmount();
     }
 
+    entry->Modifier = modifier;
     return modifier;
 }
 
@@ -9925,7 +10131,7 @@ uint32 Unit::SpellDamageBonusDone(Unit* victim, SpellInfo const* spellProto, uin
             // Impurity (dummy effect)
             if (GetTypeId() == TYPEID_PLAYER)
             {
-                PlayerSpellMap playerSpells = ToPlayer()->GetSpellMap();
+                PlayerSpellMap const& playerSpells = ToPlayer()->GetSpellMap();
                 for (PlayerSpellMap::const_iterator itr = playerSpells.begin(); itr != playerSpells.end(); ++itr)
                 {
                     if (itr->second->state == PLAYERSPELL_REMOVED || itr->second->disabled)
@@ -10459,8 +10665,21 @@ uint32 Unit::SpellDamageBonusTaken(Unit* caster, SpellInfo const* spellProto, ui
     return uint32(std::max(tmpDamage, 0.0f));
 }
 
+void Unit::EndSpellBonusBatch()
+{
+    ASSERT(m_spellBonusBatchDepth);
+    if (--m_spellBonusBatchDepth)
+        return;
+
+    m_spellDamageBonusBatch.Valid = false;
+    m_spellHealingBonusBatch.Valid = false;
+}
+
 int32 Unit::SpellBaseDamageBonusDone(SpellSchoolMask schoolMask) const
 {
+    if (m_spellBonusBatchDepth && m_spellDamageBonusBatch.IsValidFor(m_spellBonusGeneration, schoolMask))
+        return m_spellDamageBonusBatch.Value;
+
     int32 DoneAdvertisedBenefit = 0;
 
     AuraEffectList const& mDamageDone = GetAuraEffectsByType(SPELL_AURA_MOD_DAMAGE_DONE);
@@ -10495,6 +10714,10 @@ int32 Unit::SpellBaseDamageBonusDone(SpellSchoolMask schoolMask) const
                 DoneAdvertisedBenefit += int32(CalculatePct(GetTotalAttackPowerValue(BASE_ATTACK), (*i)->GetAmount()));
 
     }
+
+    if (m_spellBonusBatchDepth)
+        m_spellDamageBonusBatch.Store(m_spellBonusGeneration, schoolMask, DoneAdvertisedBenefit);
+
     return DoneAdvertisedBenefit;
 }
 
@@ -11111,6 +11334,9 @@ uint32 Unit::SpellHealingBonusTaken(Unit* caster, SpellInfo const* spellProto, u
 
 int32 Unit::SpellBaseHealingBonusDone(SpellSchoolMask schoolMask) const
 {
+    if (m_spellBonusBatchDepth && m_spellHealingBonusBatch.IsValidFor(m_spellBonusGeneration, schoolMask))
+        return m_spellHealingBonusBatch.Value;
+
     int32 advertisedBenefit = 0;
 
     AuraEffectList const& mHealingDone = GetAuraEffectsByType(SPELL_AURA_MOD_HEALING_DONE);
@@ -11139,6 +11365,10 @@ int32 Unit::SpellBaseHealingBonusDone(SpellSchoolMask schoolMask) const
             if ((*i)->GetMiscValue() & schoolMask)
                 advertisedBenefit += int32(CalculatePct(GetTotalAttackPowerValue(BASE_ATTACK), (*i)->GetAmount()));
     }
+
+    if (m_spellBonusBatchDepth)
+        m_spellHealingBonusBatch.Store(m_spellBonusGeneration, schoolMask, advertisedBenefit);
+
     return advertisedBenefit;
 }
 
@@ -13283,6 +13513,8 @@ bool Unit::HandleStatModifier(UnitMods unitMod, UnitModifierType modifierType, f
         return false;
     }
 
+    InvalidateSpellBonusBatch();
+
     switch (modifierType)
     {
         case BASE_VALUE:
@@ -13485,7 +13717,7 @@ void Unit::SetLevel(uint8 lvl)
         if (player->GetGroup())
             player->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_LEVEL);
 
-        sWorld->UpdateCharacterNameDataLevel(GetGUID(), lvl);
+        sCharacterCache->UpdateCharacterLevel(GetGUID(), lvl);
     }
 }
 
@@ -13648,6 +13880,12 @@ void Unit::RemoveFromWorld()
     if (IsInWorld())
     {
         m_duringRemoveFromWorld = true;
+        if (m_splinePositionQueued)
+        {
+            GetMap()->RemoveUnitFromSplineUpdateList(this);
+            m_splinePositionQueued = false;
+        }
+
         if (IsVehicle())
             RemoveVehicleKit();
 
@@ -14213,20 +14451,30 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
     HealInfo healInfo = HealInfo(damage);
     ProcEventInfo eventInfo = ProcEventInfo(actor, actionTarget, target, procFlag, 0, 0, procExtra, NULL, &damageInfo, &healInfo);
 
+    // Only auras listening to one of the proc flags of this event can trigger
+    // The buffer of the unit is borrowed, an event raised from within the checks below gets a new one
+    ProcIndexBucket procCandidates;
+    procCandidates.swap(m_procCandidates);
+    CollectProcCandidates(procFlag, procCandidates);
+
     ProcTriggeredList procTriggered;
     // Fill procTriggered list
-    for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr!= GetAppliedAuras().end(); ++itr)
+    for (ProcIndexBucket::const_iterator itr = procCandidates.begin(); itr != procCandidates.end(); ++itr)
     {
+        AuraApplication* aurApp = itr->Application;
+        // removed by a proc check of a previous aura
+        if (aurApp->GetRemoveMode())
+            continue;
         // Do not allow auras to proc from effect triggered by itself
-        if (procAura && procAura->Id == itr->first)
+        if (procAura && procAura->Id == itr->SpellId)
             continue;
-        ProcTriggeredData triggerData(itr->second->GetBase());
+        ProcTriggeredData triggerData(aurApp->GetBase());
         // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
         bool active = damage || (procExtra & PROC_EX_BLOCK && isVictim);
         if (isVictim)
             procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
 
-        SpellInfo const* spellProto = itr->second->GetBase()->GetSpellInfo();
+        SpellInfo const* spellProto = aurApp->GetBase()->GetSpellInfo();
 
         // only auras that has triggered spell should proc from fully absorbed damage
         if (procExtra & PROC_EX_ABSORB && isVictim)
@@ -14243,7 +14491,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
             continue;
 
         // AuraScript Hook
-        if (!triggerData.aura->CallScriptCheckProcHandlers(itr->second, eventInfo))
+        if (!triggerData.aura->CallScriptCheckProcHandlers(aurApp, eventInfo))
             continue;
 
         // Triggered spells not triggering additional spells
@@ -14252,9 +14500,9 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
 
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            if (itr->second->HasEffect(i))
+            if (aurApp->HasEffect(i))
             {
-                AuraEffect* aurEff = itr->second->GetBase()->GetEffect(i);
+                AuraEffect* aurEff = aurApp->GetBase()->GetEffect(i);
                 // Skip this auras
                 if (isNonTriggerAura[aurEff->GetAuraType()])
                     continue;
@@ -14270,6 +14518,10 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
             procTriggered.push_front(triggerData);
     }
 
+    procCandidates.clear();
+    if (procCandidates.capacity() > m_procCandidates.capacity())
+        m_procCandidates.swap(procCandidates);
+
     // Nothing found
     if (procTriggered.empty())
         return;
@@ -14821,16 +15073,36 @@ Unit* Unit::SelectNearbyTarget(Unit* exclude, float dist) const
     if (exclude)
         targets.remove(exclude);
 
-    // remove not LoS targets
     for (std::list<Unit*>::iterator tIter = targets.begin(); tIter != targets.end();)
     {
-        if (!IsWithinLOSInMap(*tIter) || (*tIter)->IsTotem() || (*tIter)->IsSpiritService() || (*tIter)->IsCritter())
+        if ((*tIter)->IsTotem() || (*tIter)->IsSpiritService() || (*tIter)->IsCritter())
             targets.erase(tIter++);
         else
             ++tIter;
     }
 
     // no appropriate targets
+    if (targets.empty())
+        return NULL;
+
+    // remove not LoS targets, all lines are tested at once, same heights as IsWithinLOS
+    std::vector<G3D::Vector3> positions;
+    positions.reserve(targets.size());
+    for (std::list<Unit*>::const_iterator tIter = targets.begin(); tIter != targets.end(); ++tIter)
+        positions.push_back(G3D::Vector3((*tIter)->GetPositionX(), (*tIter)->GetPositionY(), (*tIter)->GetPositionZ() + 2.f));
+
+    std::unique_ptr<bool[]> inLineOfSight(new bool[positions.size()]);
+    GetMap()->isInLineOfSight(GetPositionX(), GetPositionY(), GetPositionZ() + 2.f, positions.data(), uint32(positions.size()), GetPhaseMask(), inLineOfSight.get());
+
+    uint32 i = 0;
+    for (std::list<Unit*>::iterator tIter = targets.begin(); tIter != targets.end(); ++i)
+    {
+        if (!inLineOfSight[i])
+            targets.erase(tIter++);
+        else
+            ++tIter;
+    }
+
     if (targets.empty())
         return NULL;
 
@@ -15150,6 +15422,57 @@ bool Unit::InitTamedPet(Pet* pet, uint8 level, uint32 spell_id)
     return true;
 }
 
+void Unit::CollectProcCandidates(uint32 procFlag, ProcIndexBucket& candidates) const
+{
+    uint8 candidateBuckets = 0;
+    for (uint8 i = 0; i < MAX_PROC_FLAG_BITS; ++i)
+    {
+        if (procFlag & (1 << i) && !m_procIndex[i].empty())
+        {
+            candidates.insert(candidates.end(), m_procIndex[i].begin(), m_procIndex[i].end());
+            ++candidateBuckets;
+        }
+    }
+
+    // Keep the applied aura map order, auras listening to multiple flags of the event are visited once
+    if (candidateBuckets > 1)
+    {
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    }
+}
+
+uint32 Unit::CountProcCandidates(bool isVictim, Unit* target, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool useIndex)
+{
+    if (isVictim)
+        procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
+
+    uint32 count = 0;
+    SpellProcEventEntry const* spellProcEvent = NULL;
+    if (useIndex)
+    {
+        ProcIndexBucket procCandidates;
+        procCandidates.swap(m_procCandidates);
+        CollectProcCandidates(procFlag, procCandidates);
+
+        for (ProcIndexBucket::const_iterator itr = procCandidates.begin(); itr != procCandidates.end(); ++itr)
+            if (IsTriggeredAtSpellProcEvent(target, itr->Application->GetBase(), NULL, procFlag, procExtra, attType, isVictim, true, spellProcEvent))
+                ++count;
+
+        procCandidates.clear();
+        if (procCandidates.capacity() > m_procCandidates.capacity())
+            m_procCandidates.swap(procCandidates);
+    }
+    else
+    {
+        for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr != GetAppliedAuras().end(); ++itr)
+            if (IsTriggeredAtSpellProcEvent(target, itr->second->GetBase(), NULL, procFlag, procExtra, attType, isVictim, true, spellProcEvent))
+                ++count;
+    }
+
+    return count;
+}
+
 bool Unit::IsTriggeredAtSpellProcEvent(Unit* victim, Aura* aura, SpellInfo const* procSpell, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool isVictim, bool active, SpellProcEventEntry const* & spellProcEvent)
 {
     SpellInfo const* spellProto = aura->GetSpellInfo();
@@ -1220,6 +1220,21 @@ enum ReactiveType
 };
 
 #define MAX_REACTIVE 3
+
+#define MAX_PROC_FLAG_BITS 25                               // PROC_FLAG_KILLED .. PROC_FLAG_DEATH
+
+// Entry of the per proc flag bit index of applied auras, ordered like the applied aura map
+struct ProcIndexEntry
+{
+    uint32 SpellId;
+    uint32 Sequence;
+    AuraApplication* Application;
+
+    bool operator<(ProcIndexEntry const& right) const { return SpellId != right.SpellId ? SpellId < right.SpellId : Sequence < right.Sequence; }
+    bool operator==(ProcIndexEntry const& right) const { return Application == right.Application; }
+};
+
+typedef std::vector<ProcIndexEntry> ProcIndexBucket;
 #define SUMMON_SLOT_PET     0
 #define SUMMON_SLOT_TOTEM   1
 #define MAX_TOTEM_SLOT      5
@@ -1263,6 +1278,8 @@ class Unit : public WorldObject
         typedef std::pair<AuraMap::const_iterator, AuraMap::const_iterator> AuraMapBounds;
         typedef std::pair<AuraMap::iterator, AuraMap::iterator> AuraMapBoundsNonConst;
 
+        typedef std::multimap<uint64, Aura*> AuraUpdateQueue;   // owned auras by aura update time of their next due timer
+
         typedef std::multimap<uint32,  AuraApplication*> AuraApplicationMap;
         typedef std::pair<AuraApplicationMap::const_iterator, AuraApplicationMap::const_iterator> AuraApplicationMapBounds;
         typedef std::pair<AuraApplicationMap::iterator, AuraApplicationMap::iterator> AuraApplicationMapBoundsNonConst;
@@ -1363,7 +1380,7 @@ class Unit : public WorldObject
         uint8 getGender() const { return GetByteValue(UNIT_FIELD_BYTES_0, 2); }
 
         float GetStat(Stats stat) const { return float(GetUInt32Value(UNIT_FIELD_STAT0+stat)); }
-        void SetStat(Stats stat, int32 val) { SetStatInt32Value(UNIT_FIELD_STAT0+stat, val); }
+        void SetStat(Stats stat, int32 val) { SetStatInt32Value(UNIT_FIELD_STAT0+stat, val); InvalidateSpellBonusBatch(); }
         uint32 GetArmor() const { return GetResistance(SPELL_SCHOOL_NORMAL); }
         void SetArmor(int32 val) { SetResistance(SPELL_SCHOOL_NORMAL, val); }
 
@@ -1450,6 +1467,9 @@ class Unit : public WorldObject
 
         void ProcDamageAndSpell(Unit* victim, uint32 procAttacker, uint32 procVictim, uint32 procEx, uint32 amount, WeaponAttackType attType = BASE_ATTACK, SpellInfo const* procSpell = NULL, SpellInfo const* procAura = NULL);
         void ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, SpellInfo const* procSpell, uint32 damage, SpellInfo const* procAura = NULL);
+        // Auras passing IsTriggeredAtSpellProcEvent for a damaging event, taken from the proc index or from all applied
+        // auras like before the index; nothing is triggered, used to time the proc selection
+        uint32 CountProcCandidates(bool isVictim, Unit* target, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool useIndex);
 
         void GetProcAurasTriggeredOnEvent(AuraApplicationList& aurasTriggeringProc, AuraApplicationList* procAuras, ProcEventInfo eventInfo);
         void TriggerAurasProcOnEvent(CalcDamageInfo& damageInfo);
@@ -1725,11 +1745,19 @@ class Unit : public WorldObject
         void _RemoveNoStackAurasDueToAura(Aura* aura);
         bool _IsNoStackAuraDueToAura(Aura* appliedAura, Aura* existingAura) const;
         void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+        /// Must be called whenever an effect of this type is registered, unregistered or changes its amount
+        void InvalidateAuraModifierCache(AuraType auratype) { ++m_modAurasGeneration[auratype]; InvalidateSpellBonusBatch(); }
+        void InvalidateSpellBonusBatch() { ++m_spellBonusGeneration; }
+        void _RegisterAuraProc(AuraApplication* aurApp, bool apply);
 
         // m_ownedAuras container management
         AuraMap      & GetOwnedAuras()       { return m_ownedAuras; }
         AuraMap const& GetOwnedAuras() const { return m_ownedAuras; }
 
+        // Owned auras are updated only when one of their timers is due, see Aura::GetNextUpdateDelay
+        uint64 GetAuraUpdateTime() const { return m_auraUpdateTime; }
+        AuraUpdateQueue& GetAuraUpdateQueue() { return m_auraUpdateQueue; }
+
         void RemoveOwnedAura(AuraMap::iterator &i, AuraRemoveMode removeMode = AURA_REMOVE_BY_DEFAULT);
         void RemoveOwnedAura(uint32 spellId, ObjectGuid casterGUID = ObjectGuid::Empty, uint8 reqEffMask = 0, AuraRemoveMode removeMode = AURA_REMOVE_BY_DEFAULT);
         void RemoveOwnedAura(Aura* aura, AuraRemoveMode removeMode = AURA_REMOVE_BY_DEFAULT);
@@ -1975,6 +2003,11 @@ class Unit : public WorldObject
         Unit* GetMagicHitRedirectTarget(Unit* victim, SpellInfo const* spellInfo);
         Unit* GetMeleeHitRedirectTarget(Unit* victim, SpellInfo const* spellInfo = NULL);
 
+        /// While a spell applies its effects to its targets the caster side spell power is computed once
+        /// per school mask, it is recomputed only if auras, stats or base spell power of the caster change
+        void BeginSpellBonusBatch() { ++m_spellBonusBatchDepth; }
+        void EndSpellBonusBatch();
+
         int32  SpellBaseDamageBonusDone(SpellSchoolMask schoolMask) const;
         int32  SpellBaseDamageBonusTaken(SpellSchoolMask schoolMask) const;
         uint32 SpellDamageBonusDone(Unit* victim, SpellInfo const* spellProto, uint32 pdamage, DamageEffectType damagetype, uint32 stack = 1) const;
@@ -2040,6 +2073,7 @@ class Unit : public WorldObject
 
         bool IsStopped() const { return !(HasUnitState(UNIT_STATE_MOVING)); }
         void StopMoving();
+        void UpdateQueuedSplinePosition();
 
         void AddUnitMovementFlag(uint32 f) { m_movementInfo.flags |= f; }
         void RemoveUnitMovementFlag(uint32 f) { m_movementInfo.flags &= ~f; }
@@ -2211,13 +2245,69 @@ class Unit : public WorldObject
         AuraMap m_ownedAuras;
         AuraApplicationMap m_appliedAuras;
         AuraList m_removedAuras;
-        AuraMap::iterator m_auraUpdateIterator;
+        AuraUpdateQueue m_auraUpdateQueue;
+        uint64 m_auraUpdateTime;                            // sum of _UpdateSpells diffs
         uint32 m_removedAurasCount;
 
+        enum AuraModifierQuery
+        {
+            AURA_MODIFIER_TOTAL,
+            AURA_MODIFIER_MULTIPLIER,
+            AURA_MODIFIER_MAX_POSITIVE,
+            AURA_MODIFIER_MAX_NEGATIVE,
+            AURA_MODIFIER_TOTAL_BY_MISC_MASK,
+            AURA_MODIFIER_MULTIPLIER_BY_MISC_MASK,
+            AURA_MODIFIER_MAX_POSITIVE_BY_MISC_MASK,
+            AURA_MODIFIER_MAX_NEGATIVE_BY_MISC_MASK,
+            AURA_MODIFIER_TOTAL_BY_MISC_VALUE,
+            AURA_MODIFIER_MULTIPLIER_BY_MISC_VALUE,
+            AURA_MODIFIER_MAX_POSITIVE_BY_MISC_VALUE,
+            AURA_MODIFIER_MAX_NEGATIVE_BY_MISC_VALUE
+        };
+
+        struct AuraModifierCacheEntry
+        {
+            uint32 Generation;
+            union
+            {
+                int32 Modifier;
+                float Multiplier;
+            };
+        };
+
+        typedef std::unordered_map<uint64, AuraModifierCacheEntry> AuraModifierCache;
+
+        /// Returns true if entry holds a result still valid for the current effects of this type,
+        /// otherwise the caller has to compute the result and store it into entry
+        bool GetCachedAuraModifier(AuraType auratype, AuraModifierQuery query, uint32 misc, AuraModifierCacheEntry*& entry) const;
+
         AuraEffectList m_modAuras[TOTAL_AURAS];
+        uint32 m_modAurasGeneration[TOTAL_AURAS];      // bumped on every change of m_modAuras or of an amount in it
+        mutable AuraModifierCache m_auraModifierCache; // results of the GetTotalAuraModifier family, valid while generation matches
         AuraList m_scAuras;                        // cast singlecast auras
         AuraApplicationList m_interruptableAuras;  // auras which have interrupt mask applied on unit
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
+        ProcIndexBucket m_procIndex[MAX_PROC_FLAG_BITS]; // applied auras which can proc, by bit of their proc flags
+        uint32 m_procIndexSequence;
+        ProcIndexBucket m_procCandidates;          // kept between ProcDamageAndSpellFor calls for its capacity
+
+        struct SpellBonusBatchEntry
+        {
+            SpellBonusBatchEntry() : Valid(false), Generation(0), SchoolMask(0), Value(0) { }
+
+            bool IsValidFor(uint32 generation, uint32 schoolMask) const { return Valid && Generation == generation && SchoolMask == schoolMask; }
+            void Store(uint32 generation, uint32 schoolMask, int32 value) { Valid = true; Generation = generation; SchoolMask = schoolMask; Value = value; }
+
+            bool Valid;
+            uint32 Generation;
+            uint32 SchoolMask;
+            int32 Value;
+        };
+
+        uint32 m_spellBonusBatchDepth;
+        uint32 m_spellBonusGeneration;                     // bumped on every change of auras, stats or base spell power
+        mutable SpellBonusBatchEntry m_spellDamageBonusBatch;
+        mutable SpellBonusBatchEntry m_spellHealingBonusBatch;
         uint32 m_interruptMask;
 
         float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
@@ -2250,6 +2340,7 @@ class Unit : public WorldObject
 
         void DisableSpline();
     private:
+        void CollectProcCandidates(uint32 procFlag, ProcIndexBucket& candidates) const;
         bool IsTriggeredAtSpellProcEvent(Unit* victim, Aura* aura, SpellInfo const* procSpell, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool isVictim, bool active, SpellProcEventEntry const* & spellProcEvent);
         bool HandleDummyAuraProc(Unit* victim, uint32 damage, AuraEffect* triggeredByAura, SpellInfo const* procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown);
         bool HandleAuraProc(Unit* victim, uint32 damage, Aura* triggeredByAura, SpellInfo const* procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown, bool * handled);
@@ -2259,7 +2350,7 @@ class Unit : public WorldObject
         bool HandleAuraRaidProcFromCharge(AuraEffect* triggeredByAura);
 
         void UpdateSplineMovement(uint32 t_diff);
-        void UpdateSplinePosition();
+        void UpdateSplinePosition(bool skipSmallSteps = false);
 
         // player or player's pet
         float GetCombatRatingReduction(CombatRating cr) const;
@@ -2276,6 +2367,7 @@ class Unit : public WorldObject
         uint32 m_CombatTimer;
         uint32 m_lastManaUse;                               // msecs
         TimeTrackerSmall m_movesplineTimer;
+        bool m_splinePositionQueued;                        // in the spline update list of the map
 
         Diminishing m_Diminishing;
         // Manage all Units that are threatened by us
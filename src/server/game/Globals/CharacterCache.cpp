@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharacterCache.h"
+#include "DatabaseEnv.h"
+#include "Log.h"
+#include "Player.h"
+#include "Timer.h"
+#include "Util.h"
+
+namespace
+{
+    // Names are unique regardless of case, same as the database collation
+    std::string GetNameKey(std::string const& name)
+    {
+        std::wstring wname;
+        if (!Utf8toWStr(name, wname))
+            return name;
+
+        wstrToLower(wname);
+
+        std::string key;
+        if (!WStrToUtf8(wname, key))
+            return name;
+
+        return key;
+    }
+}
+
+void CharacterCache::LoadCharacterCacheStorage()
+{
+    uint32 oldMSTime = getMSTime();
+
+    for (uint32 i = 0; i < CHARACTER_CACHE_SHARDS; ++i)
+    {
+        _entries[i].Entries.clear();
+        _names[i].Guids.clear();
+    }
+
+    QueryResult result = CharacterDatabase.Query("SELECT guid, name, account, race, gender, class, level FROM characters WHERE deleteDate IS NULL");
+    if (!result)
+    {
+        TC_LOG_INFO("server.loading", ">> Loaded 0 characters into the character cache. DB table `characters` is empty.");
+        return;
+    }
+
+    uint32 count = 0;
+
+    do
+    {
+        Field* fields = result->Fetch();
+        AddCharacterCacheEntry(ObjectGuid(HIGHGUID_PLAYER, fields[0].GetUInt32()), fields[2].GetUInt32() /*account*/, fields[1].GetString(),
+            fields[4].GetUInt8() /*gender*/, fields[3].GetUInt8() /*race*/, fields[5].GetUInt8() /*class*/, fields[6].GetUInt8() /*level*/);
+        ++count;
+    } while (result->NextRow());
+
+    TC_LOG_INFO("server.loading", ">> Loaded %u characters into the character cache in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
+}
+
+void CharacterCache::AddCharacterCacheEntry(ObjectGuid guid, uint32 accountId, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level)
+{
+    std::string oldName;
+    {
+        EntryShard& shard = GetEntryShard(guid);
+        boost::unique_lock<boost::shared_mutex> lock(shard.Lock);
+
+        CharacterCacheEntry& entry = shard.Entries[guid.GetCounter()];
+        oldName.swap(entry.Name);
+        entry.Guid = guid;
+        entry.Name = name;
+        entry.AccountId = accountId;
+        entry.Race = race;
+        entry.Sex = gender;
+        entry.Class = playerClass;
+        entry.Level = level;
+    }
+
+    if (!oldName.empty() && oldName != name)
+        RemoveName(oldName, guid);
+    AddName(name, guid);
+
+    Notify(guid, CHARACTER_CACHE_ADDED);
+}
+
+void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid guid)
+{
+    std::string name;
+    {
+        EntryShard& shard = GetEntryShard(guid);
+        boost::unique_lock<boost::shared_mutex> lock(shard.Lock);
+
+        auto itr = shard.Entries.find(guid.GetCounter());
+        if (itr == shard.Entries.end())
+            return;
+
+        name.swap(itr->second.Name);
+        shard.Entries.erase(itr);
+    }
+
+    RemoveName(name, guid);
+
+    Notify(guid, CHARACTER_CACHE_DELETED);
+}
+
+void CharacterCache::UpdateCharacterData(ObjectGuid guid, std::string const& name, uint8 gender /*= GENDER_NONE*/, uint8 race /*= RACE_NONE*/)
+{
+    std::string oldName;
+    uint32 updateFlags = CHARACTER_CACHE_NAME;
+    {
+        EntryShard& shard = GetEntryShard(guid);
+        boost::unique_lock<boost::shared_mutex> lock(shard.Lock);
+
+        auto itr = shard.Entries.find(guid.GetCounter());
+        if (itr == shard.Entries.end())
+            return;
+
+        oldName = itr->second.Name;
+        itr->second.Name = name;
+
+        if (gender != GENDER_NONE)
+        {
+            itr->second.Sex = gender;
+            updateFlags |= CHARACTER_CACHE_APPEARANCE;
+        }
+
+        if (race != RACE_NONE)
+        {
+            itr->second.Race = race;
+            updateFlags |= CHARACTER_CACHE_APPEARANCE;
+        }
+    }
+
+    if (oldName != name)
+    {
+        RemoveName(oldName, guid);
+        AddName(name, guid);
+    }
+
+    Notify(guid, updateFlags);
+}
+
+void CharacterCache::UpdateCharacterLevel(ObjectGuid guid, uint8 level)
+{
+    {
+        EntryShard& shard = GetEntryShard(guid);
+        boost::unique_lock<boost::shared_mutex> lock(shard.Lock);
+
+        auto itr = shard.Entries.find(guid.GetCounter());
+        if (itr == shard.Entries.end() || itr->second.Level == level)
+            return;
+
+        itr->second.Level = level;
+    }
+
+    Notify(guid, CHARACTER_CACHE_LEVEL);
+}
+
+bool CharacterCache::HasCharacterCacheEntry(ObjectGuid guid) const
+{
+    EntryShard const& shard = GetEntryShard(guid);
+    boost::shared_lock<boost::shared_mutex> lock(shard.Lock);
+    return shard.Entries.find(guid.GetCounter()) != shard.Entries.end();
+}
+
+bool CharacterCache::GetCharacterCacheByGuid(ObjectGuid guid, CharacterCacheEntry& entry) const
+{
+    EntryShard const& shard = GetEntryShard(guid);
+    boost::shared_lock<boost::shared_mutex> lock(shard.Lock);
+
+    auto itr = shard.Entries.find(guid.GetCounter());
+    if (itr == shard.Entries.end())
+        return false;
+
+    entry = itr->second;
+    return true;
+}
+
+ObjectGuid CharacterCache::GetCharacterGuidByName(std::string const& name) const
+{
+    std::string key = GetNameKey(name);
+    NameShard const& shard = GetNameShard(key);
+    boost::shared_lock<boost::shared_mutex> lock(shard.Lock);
+
+    auto itr = shard.Guids.find(key);
+    if (itr == shard.Guids.end())
+        return ObjectGuid::Empty;
+
+    return itr->second;
+}
+
+bool CharacterCache::GetCharacterNameByGuid(ObjectGuid guid, std::string& name) const
+{
+    EntryShard const& shard = GetEntryShard(guid);
+    boost::shared_lock<boost::shared_mutex> lock(shard.Lock);
+
+    auto itr = shard.Entries.find(guid.GetCounter());
+    if (itr == shard.Entries.end())
+        return false;
+
+    name = itr->second.Name;
+    return true;
+}
+
+uint32 CharacterCache::GetCharacterTeamByGuid(ObjectGuid guid) const
+{
+    EntryShard const& shard = GetEntryShard(guid);
+    boost::shared_lock<boost::shared_mutex> lock(shard.Lock);
+
+    auto itr = shard.Entries.find(guid.GetCounter());
+    if (itr == shard.Entries.end())
+        return 0;
+
+    return Player::TeamForRace(itr->second.Race);
+}
+
+uint32 CharacterCache::GetCharacterAccountIdByGuid(ObjectGuid guid) const
+{
+    EntryShard const& shard = GetEntryShard(guid);
+    boost::shared_lock<boost::shared_mutex> lock(shard.Lock);
+
+    auto itr = shard.Entries.find(guid.GetCounter());
+    if (itr == shard.Entries.end())
+        return 0;
+
+    return itr->second.AccountId;
+}
+
+uint32 CharacterCache::GetCharacterAccountIdByName(std::string const& name) const
+{
+    ObjectGuid guid = GetCharacterGuidByName(name);
+    if (guid.IsEmpty())
+        return 0;
+
+    return GetCharacterAccountIdByGuid(guid);
+}
+
+void CharacterCache::AddName(std::string const& name, ObjectGuid guid)
+{
+    std::string key = GetNameKey(name);
+    NameShard& shard = GetNameShard(key);
+    boost::unique_lock<boost::shared_mutex> lock(shard.Lock);
+
+    // On a name conflict (dump loaded character, has to rename at login) the current owner keeps it
+    shard.Guids.insert(std::make_pair(key, guid));
+}
+
+void CharacterCache::RemoveName(std::string const& name, ObjectGuid guid)
+{
+    std::string key = GetNameKey(name);
+    NameShard& shard = GetNameShard(key);
+    boost::unique_lock<boost::shared_mutex> lock(shard.Lock);
+
+    // The name may already be taken by another character (pending rename after a dump load)
+    auto itr = shard.Guids.find(key);
+    if (itr != shard.Guids.end() && itr->second == guid)
+        shard.Guids.erase(itr);
+}
+
+void CharacterCache::Notify(ObjectGuid guid, uint32 updateFlags) const
+{
+    for (Listener const& listener : _listeners)
+        listener(guid, updateFlags);
+}
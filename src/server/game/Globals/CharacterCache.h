@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_CHARACTERCACHE_H
+#define TRINITY_CHARACTERCACHE_H
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+#include "Define.h"
+#include "ObjectGuid.h"
+#include "SharedDefines.h"
+
+struct CharacterCacheEntry
+{
+    ObjectGuid Guid;
+    std::string Name;
+    uint32 AccountId;
+    uint8 Class;
+    uint8 Race;
+    uint8 Sex;
+    uint8 Level;
+};
+
+enum CharacterCacheUpdateFlags
+{
+    CHARACTER_CACHE_ADDED       = 0x01,
+    CHARACTER_CACHE_NAME        = 0x02,
+    CHARACTER_CACHE_APPEARANCE  = 0x04,                     // gender or race
+    CHARACTER_CACHE_LEVEL       = 0x08,
+    CHARACTER_CACHE_DELETED     = 0x10
+};
+
+#define CHARACTER_CACHE_SHARDS 16
+
+/// Name, account, race, class, gender and level of every (not deleted) character, online or not.
+/// Loaded at startup and kept in sync wherever these change, so lookups never need the database.
+/// Entries are spread over shards with their own lock, readers of different shards never contend.
+class CharacterCache
+{
+    public:
+        typedef std::function<void(ObjectGuid guid, uint32 updateFlags)> Listener;
+
+        static CharacterCache* instance()
+        {
+            static CharacterCache instance;
+            return &instance;
+        }
+
+        void LoadCharacterCacheStorage();
+
+        /// Listeners are called after every change with a mask of CharacterCacheUpdateFlags, must be registered at startup
+        void RegisterListener(Listener&& listener) { _listeners.push_back(std::move(listener)); }
+
+        void AddCharacterCacheEntry(ObjectGuid guid, uint32 accountId, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level);
+        void DeleteCharacterCacheEntry(ObjectGuid guid);
+
+        void UpdateCharacterData(ObjectGuid guid, std::string const& name, uint8 gender = GENDER_NONE, uint8 race = RACE_NONE);
+        void UpdateCharacterLevel(ObjectGuid guid, uint8 level);
+
+        bool HasCharacterCacheEntry(ObjectGuid guid) const;
+        bool GetCharacterCacheByGuid(ObjectGuid guid, CharacterCacheEntry& entry) const;
+
+        ObjectGuid GetCharacterGuidByName(std::string const& name) const;
+        bool GetCharacterNameByGuid(ObjectGuid guid, std::string& name) const;
+        uint32 GetCharacterTeamByGuid(ObjectGuid guid) const;
+        uint32 GetCharacterAccountIdByGuid(ObjectGuid guid) const;
+        uint32 GetCharacterAccountIdByName(std::string const& name) const;
+
+    private:
+        CharacterCache() { }
+        ~CharacterCache() { }
+
+        struct EntryShard
+        {
+            mutable boost::shared_mutex Lock;
+            std::unordered_map<uint32, CharacterCacheEntry> Entries;
+        };
+
+        struct NameShard
+        {
+            mutable boost::shared_mutex Lock;
+            std::unordered_map<std::string, ObjectGuid> Guids;  // by lower case name
+        };
+
+        EntryShard& GetEntryShard(ObjectGuid guid) { return _entries[guid.GetCounter() % CHARACTER_CACHE_SHARDS]; }
+        EntryShard const& GetEntryShard(ObjectGuid guid) const { return _entries[guid.GetCounter() % CHARACTER_CACHE_SHARDS]; }
+        NameShard& GetNameShard(std::string const& key) { return _names[std::hash<std::string>()(key) % CHARACTER_CACHE_SHARDS]; }
+        NameShard const& GetNameShard(std::string const& key) const { return _names[std::hash<std::string>()(key) % CHARACTER_CACHE_SHARDS]; }
+
+        void AddName(std::string const& name, ObjectGuid guid);
+        void RemoveName(std::string const& name, ObjectGuid guid);
+        void Notify(ObjectGuid guid, uint32 updateFlags) const;
+
+        EntryShard _entries[CHARACTER_CACHE_SHARDS];
+        NameShard _names[CHARACTER_CACHE_SHARDS];
+        std::vector<Listener> _listeners;
+
+        CharacterCache(CharacterCache const&) = delete;
+        CharacterCache& operator=(CharacterCache const&) = delete;
+};
+
+#define sCharacterCache CharacterCache::instance()
+
+#endif
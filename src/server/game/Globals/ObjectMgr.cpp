@@ -21,6 +21,7 @@
 #include "ArenaTeam.h"
 #include "ArenaTeamMgr.h"
 #include "BattlegroundMgr.h"
+#include "CharacterCache.h"
 #include "Chat.h"
 #include "Common.h"
 #include "DatabaseEnv.h"
@@ -2120,6 +2121,11 @@ Player* ObjectMgr::GetPlayerByLowGUID(uint32 lowguid) const
 // name must be checked to correctness (if received) before call this function
 ObjectGuid ObjectMgr::GetPlayerGUIDByName(std::string const& name) const
 {
+    // Every character not pending deletion is cached
+    ObjectGuid guid = sCharacterCache->GetCharacterGuidByName(name);
+    if (!guid.IsEmpty())
+        return guid;
+
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_GUID_BY_NAME);
 
     stmt->setString(0, name);
@@ -2134,12 +2140,9 @@ ObjectGuid ObjectMgr::GetPlayerGUIDByName(std::string const& name) const
 
 bool ObjectMgr::GetPlayerNameByGUID(ObjectGuid guid, std::string& name) const
 {
-    // prevent DB access for online player
-    if (Player* player = ObjectAccessor::FindConnectedPlayer(guid))
-    {
-        name = player->GetName();
+    // prevent DB access for cached (online or offline) player
+    if (sCharacterCache->GetCharacterNameByGuid(guid, name))
         return true;
-    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_NAME);
 
@@ -2158,11 +2161,9 @@ bool ObjectMgr::GetPlayerNameByGUID(ObjectGuid guid, std::string& name) const
 
 uint32 ObjectMgr::GetPlayerTeamByGUID(ObjectGuid guid) const
 {
-    // prevent DB access for online player
-    if (Player* player = ObjectAccessor::FindConnectedPlayer(guid))
-    {
-        return Player::TeamForRace(player->getRace());
-    }
+    // prevent DB access for cached (online or offline) player
+    if (uint32 team = sCharacterCache->GetCharacterTeamByGuid(guid))
+        return team;
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_RACE);
 
@@ -2181,11 +2182,9 @@ uint32 ObjectMgr::GetPlayerTeamByGUID(ObjectGuid guid) const
 
 uint32 ObjectMgr::GetPlayerAccountIdByGUID(ObjectGuid guid) const
 {
-    // prevent DB access for online player
-    if (Player* player = ObjectAccessor::FindConnectedPlayer(guid))
-    {
-        return player->GetSession()->GetAccountId();
-    }
+    // prevent DB access for cached (online or offline) player
+    if (uint32 accountId = sCharacterCache->GetCharacterAccountIdByGuid(guid))
+        return accountId;
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_ACCOUNT_BY_GUID);
 
@@ -2204,6 +2203,9 @@ uint32 ObjectMgr::GetPlayerAccountIdByGUID(ObjectGuid guid) const
 
 uint32 ObjectMgr::GetPlayerAccountIdByPlayerName(const std::string& name) const
 {
+    if (uint32 accountId = sCharacterCache->GetCharacterAccountIdByName(name))
+        return accountId;
+
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_ACCOUNT_BY_NAME);
 
     stmt->setString(0, name);
@@ -5142,10 +5144,16 @@ void ObjectMgr::ValidateSpellScripts()
         sScriptMgr->CreateSpellScriptLoaders(itr->first, SpellScriptLoaders);
         itr = _spellScriptsStore.upper_bound(itr->first);
 
+        // hooks registered by the valid scripts, the loading bit marks that the spell has scripts at all
+        uint32 spellScriptHookMask = 0;
+        uint32 auraScriptHookMask = 0;
+
         for (std::vector<std::pair<SpellScriptLoader *, SpellScriptsContainer::iterator> >::iterator sitr = SpellScriptLoaders.begin(); sitr != SpellScriptLoaders.end(); ++sitr)
         {
             SpellScript* spellScript = sitr->first->GetSpellScript();
             AuraScript* auraScript = sitr->first->GetAuraScript();
+            uint32 spellHookMask = 0;
+            uint32 auraHookMask = 0;
             bool valid = true;
             if (!spellScript && !auraScript)
             {
@@ -5158,6 +5166,7 @@ void ObjectMgr::ValidateSpellScripts()
                 spellScript->_Register();
                 if (!spellScript->_Validate(spellEntry))
                     valid = false;
+                spellHookMask = spellScript->_GetRegisteredHookMask() | (1 << SPELL_SCRIPT_STATE_LOADING);
                 delete spellScript;
             }
             if (auraScript)
@@ -5166,13 +5175,22 @@ void ObjectMgr::ValidateSpellScripts()
                 auraScript->_Register();
                 if (!auraScript->_Validate(spellEntry))
                     valid = false;
+                auraHookMask = auraScript->_GetRegisteredHookMask() | (1 << SPELL_SCRIPT_STATE_LOADING);
                 delete auraScript;
             }
             if (!valid)
             {
                 _spellScriptsStore.erase(sitr->second);
+                continue;
             }
+
+            spellScriptHookMask |= spellHookMask;
+            auraScriptHookMask |= auraHookMask;
         }
+
+        SpellInfo* spellInfo = const_cast<SpellInfo*>(spellEntry);
+        spellInfo->SpellScriptHookMask = spellScriptHookMask;
+        spellInfo->AuraScriptHookMask = auraScriptHookMask;
         ++count;
     }
 
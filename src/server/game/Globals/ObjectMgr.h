@@ -765,10 +765,10 @@ class ObjectMgr
         /**
         * Retrieves the player name by guid.
         *
-        * If the player is online, the name is retrieved immediately otherwise
-        * a database query is done.
+        * The name is taken from the character cache, a database query is only
+        * done for characters that are not cached (pending deletion).
         *
-        * @remark Use sWorld->GetCharacterNameData because it doesn't require a database query when player is offline
+        * @remark sCharacterCache->GetCharacterCacheByGuid also provides race, class, gender and level
         *
         * @param guid player full guid
         * @param name returned name
@@ -21,6 +21,7 @@
 #include "ArenaTeamMgr.h"
 #include "Battleground.h"
 #include "CalendarMgr.h"
+#include "CharacterCache.h"
 #include "Chat.h"
 #include "Common.h"
 #include "DatabaseEnv.h"
@@ -217,6 +218,10 @@ void WorldSession::HandleCharEnum(PreparedQueryResult result)
 
     data << num;
 
+    // The last played character is most likely the one the client has selected
+    ObjectGuid prefetchGuid;
+    uint32 prefetchLogoutTime = 0;
+
     _legitCharacters.clear();
     if (result)
     {
@@ -228,10 +233,22 @@ void WorldSession::HandleCharEnum(PreparedQueryResult result)
             {
                 // Do not allow banned characters to log in
                 if (!(*result)[20].GetUInt32())
+                {
                     _legitCharacters.insert(guid);
 
-                if (!sWorld->HasCharacterNameData(guid)) // This can happen if characters are inserted into the database manually. Core hasn't loaded name data yet.
-                    sWorld->AddCharacterNameData(guid, (*result)[1].GetString(), (*result)[4].GetUInt8(), (*result)[2].GetUInt8(), (*result)[3].GetUInt8(), (*result)[7].GetUInt8());
+                    // logout_time is the last column of both enum statements
+                    // characters that have to be changed before entering the world are not worth loading
+                    uint32 logoutTime = (*result)[result->GetFieldCount() - 1].GetUInt32();
+                    if (!((*result)[15].GetUInt16() & (AT_LOGIN_RENAME | AT_LOGIN_CUSTOMIZE | AT_LOGIN_CHANGE_FACTION | AT_LOGIN_CHANGE_RACE)) &&
+                        (prefetchGuid.IsEmpty() || logoutTime > prefetchLogoutTime))
+                    {
+                        prefetchGuid = guid;
+                        prefetchLogoutTime = logoutTime;
+                    }
+                }
+
+                if (!sCharacterCache->HasCharacterCacheEntry(guid)) // This can happen if characters are inserted into the database manually. Core hasn't loaded name data yet.
+                    sCharacterCache->AddCharacterCacheEntry(guid, GetAccountId(), (*result)[1].GetString(), (*result)[4].GetUInt8(), (*result)[2].GetUInt8(), (*result)[3].GetUInt8(), (*result)[7].GetUInt8());
                 ++num;
             }
         }
@@ -241,10 +258,71 @@ void WorldSession::HandleCharEnum(PreparedQueryResult result)
     data.put<uint8>(0, num);
 
     SendPacket(&data);
+
+    // A login started meanwhile keeps its load
+    if (PlayerLoading())
+        return;
+
+    // Only for the first login of a session and not shortly after a logout of the account, a replaced session
+    // or an earlier one may still have its character save queued and the prefetch could read the rows before it
+    _loginPrefetch.reset();
+    if (!prefetchGuid.IsEmpty() && !m_GUIDLow && sWorld->getIntConfig(CONFIG_CHARACTER_LOGIN_PREFETCH_TIMEOUT) &&
+        !sWorld->HasRecentLogoutSave(GetAccountId()))
+        PrefetchPlayerLogin(prefetchGuid);
+}
+
+CharacterLoginPrefetch::~CharacterLoginPrefetch()
+{
+    delete Holder;
+}
+
+void WorldSession::PrefetchPlayerLogin(ObjectGuid guid)
+{
+    LoginQueryHolder* holder = new LoginQueryHolder(GetAccountId(), guid);
+    if (!holder->Initialize())
+    {
+        delete holder;
+        return;
+    }
+
+    std::shared_ptr<CharacterLoginPrefetch> prefetch = std::make_shared<CharacterLoginPrefetch>(guid);
+    prefetch->Time = getMSTime();
+    _loginPrefetch = prefetch;
+
+    CharacterDatabase.DelayQueryHolder(holder, _queryCompletionQueue, [this, prefetch](SQLQueryHolder* result)
+    {
+        LoginQueryHolder* holder = static_cast<LoginQueryHolder*>(result);
+
+        // The login waits for this load, it must continue even if the prefetch was dropped meanwhile
+        if (prefetch->LoginRequested)
+        {
+            if (prefetch == _loginPrefetch)
+                _loginPrefetch.reset();
+            HandlePlayerLogin(holder);
+            return;
+        }
+
+        // Replaced or dropped meanwhile
+        if (prefetch != _loginPrefetch)
+        {
+            delete holder;
+            return;
+        }
+
+        prefetch->Holder = holder;
+    });
 }
 
 void WorldSession::HandleCharEnumOpcode(WorldPacket& /*recvData*/)
 {
+    // the character list is not shown while a character enters the world
+    if (PlayerLoading())
+        return;
+
+    // the list is already on its way, a client repeating the request must not queue more queries
+    if (_charEnumPending)
+        return;
+
     // remove expired bans
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_EXPIRED_BANS);
     CharacterDatabase.Execute(stmt);
@@ -259,7 +337,12 @@ void WorldSession::HandleCharEnumOpcode(WorldPacket& /*recvData*/)
     stmt->setUInt8(0, PET_SAVE_AS_CURRENT);
     stmt->setUInt32(1, GetAccountId());
 
-    _charEnumCallback = CharacterDatabase.AsyncQuery(stmt);
+    _charEnumPending = true;
+    CharacterDatabase.AsyncQuery(stmt, _queryCompletionQueue, [this](PreparedQueryResult result)
+    {
+        _charEnumPending = false;
+        HandleCharEnum(result);
+    });
 }
 
 void WorldSession::HandleCharCreateOpcode(WorldPacket& recvData)
@@ -397,37 +480,39 @@ void WorldSession::HandleCharCreateOpcode(WorldPacket& recvData)
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHECK_NAME);
     stmt->setString(0, createInfo.Name);
 
-    delete _charCreateCallback.GetParam(); // Delete existing if any, to make the callback chain reset to stage 0
-    _charCreateCallback.SetParam(new CharacterCreateInfo(std::move(createInfo)));
-    _charCreateCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+    // Replaces existing if any, the callbacks of the previous chain will find it stale and stop
+    std::shared_ptr<CharacterCreateInfo> info = std::make_shared<CharacterCreateInfo>(std::move(createInfo));
+    _charCreateInfo = info;
+    CharacterDatabase.AsyncQuery(stmt, _queryCompletionQueue, [this, info](PreparedQueryResult result) { HandleCharCreateCallback(result, info); });
 }
 
-void WorldSession::HandleCharCreateCallback(PreparedQueryResult result, CharacterCreateInfo* createInfo)
+void WorldSession::HandleCharCreateCallback(PreparedQueryResult result, std::shared_ptr<CharacterCreateInfo> createInfo)
 {
     /** This is a series of callbacks executed consecutively as a result from the database becomes available.
         This is much more efficient than synchronous requests on packet handler, and much less DoS prone.
         It also prevents data syncrhonisation errors.
     */
-    switch (_charCreateCallback.GetStage())
+    if (createInfo != _charCreateInfo)
+        return;
+
+    auto nextStage = [this, createInfo](PreparedQueryResult result) { HandleCharCreateCallback(result, createInfo); };
+
+    switch (createInfo->Stage)
     {
         case 0:
         {
             if (result)
             {
                 SendCharCreate(CHAR_CREATE_NAME_IN_USE);
-                delete createInfo;
-                _charCreateCallback.Reset();
+                _charCreateInfo.reset();
                 return;
             }
 
-            ASSERT(_charCreateCallback.GetParam() == createInfo);
-
             PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_SUM_REALM_CHARACTERS);
             stmt->setUInt32(0, GetAccountId());
 
-            _charCreateCallback.FreeResult();
-            _charCreateCallback.SetFutureResult(LoginDatabase.AsyncQuery(stmt));
-            _charCreateCallback.NextStage();
+            ++createInfo->Stage;
+            LoginDatabase.AsyncQuery(stmt, _queryCompletionQueue, nextStage);
             break;
         }
         case 1:
@@ -445,19 +530,15 @@ void WorldSession::HandleCharCreateCallback(PreparedQueryResult result, Characte
             if (acctCharCount >= sWorld->getIntConfig(CONFIG_CHARACTERS_PER_ACCOUNT))
             {
                 SendCharCreate(CHAR_CREATE_ACCOUNT_LIMIT);
-                delete createInfo;
-                _charCreateCallback.Reset();
+                _charCreateInfo.reset();
                 return;
             }
 
-            ASSERT(_charCreateCallback.GetParam() == createInfo);
-
             PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_SUM_CHARS);
             stmt->setUInt32(0, GetAccountId());
 
-            _charCreateCallback.FreeResult();
-            _charCreateCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
-            _charCreateCallback.NextStage();
+            ++createInfo->Stage;
+            CharacterDatabase.AsyncQuery(stmt, _queryCompletionQueue, nextStage);
             break;
         }
         case 2:
@@ -470,8 +551,7 @@ void WorldSession::HandleCharCreateCallback(PreparedQueryResult result, Characte
                 if (createInfo->CharCount >= sWorld->getIntConfig(CONFIG_CHARACTERS_PER_REALM))
                 {
                     SendCharCreate(CHAR_CREATE_SERVER_LIMIT);
-                    delete createInfo;
-                    _charCreateCallback.Reset();
+                    _charCreateInfo.reset();
                     return;
                 }
             }
@@ -480,19 +560,17 @@ void WorldSession::HandleCharCreateCallback(PreparedQueryResult result, Characte
             uint32 skipCinematics = sWorld->getIntConfig(CONFIG_SKIP_CINEMATICS);
 			bool allowTwoSideAccounts = true;
 
-            _charCreateCallback.FreeResult();
-
             if (!allowTwoSideAccounts || skipCinematics == 1 || createInfo->Class == CLASS_DEATH_KNIGHT)
             {
                 PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_CREATE_INFO);
                 stmt->setUInt32(0, GetAccountId());
                 stmt->setUInt32(1, (skipCinematics == 1 || createInfo->Class == CLASS_DEATH_KNIGHT) ? 10 : 1);
-                _charCreateCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
-                _charCreateCallback.NextStage();
+                ++createInfo->Stage;
+                CharacterDatabase.AsyncQuery(stmt, _queryCompletionQueue, nextStage);
                 return;
             }
 
-            _charCreateCallback.NextStage();
+            ++createInfo->Stage;
             HandleCharCreateCallback(PreparedQueryResult(NULL), createInfo);   // Will jump to case 3
             break;
         }
@@ -525,8 +603,7 @@ void WorldSession::HandleCharCreateCallback(PreparedQueryResult result, Characte
                         if (freeHeroicSlots == 0)
                         {
                             SendCharCreate(CHAR_CREATE_UNIQUE_CLASS_LIMIT);
-                            delete createInfo;
-                            _charCreateCallback.Reset();
+                            _charCreateInfo.reset();
                             return;
                         }
                     }
@@ -550,8 +627,7 @@ void WorldSession::HandleCharCreateCallback(PreparedQueryResult result, Characte
                     if (accTeam != team)
                     {
                         SendCharCreate(CHAR_CREATE_PVP_TEAMS_VIOLATION);
-                        delete createInfo;
-                        _charCreateCallback.Reset();
+                        _charCreateInfo.reset();
                         return;
                     }
                 }
@@ -580,8 +656,7 @@ void WorldSession::HandleCharCreateCallback(PreparedQueryResult result, Characte
                             if (freeHeroicSlots == 0)
                             {
                                 SendCharCreate(CHAR_CREATE_UNIQUE_CLASS_LIMIT);
-                                delete createInfo;
-                                _charCreateCallback.Reset();
+                                _charCreateInfo.reset();
                                 return;
                             }
                         }
@@ -599,21 +674,19 @@ void WorldSession::HandleCharCreateCallback(PreparedQueryResult result, Characte
             if (checkHeroicReqs && !hasHeroicReqLevel)
             {
                 SendCharCreate(CHAR_CREATE_LEVEL_REQUIREMENT);
-                delete createInfo;
-                _charCreateCallback.Reset();
+                _charCreateInfo.reset();
                 return;
             }
 
             Player newChar(this);
             newChar.GetMotionMaster()->Initialize();
-            if (!newChar.Create(sObjectMgr->GenerateLowGuid(HIGHGUID_PLAYER), createInfo))
+            if (!newChar.Create(sObjectMgr->GenerateLowGuid(HIGHGUID_PLAYER), createInfo.get()))
             {
                 // Player not create (race/class/etc problem?)
                 newChar.CleanupsBeforeDelete();
 
                 SendCharCreate(CHAR_CREATE_ERROR);
-                delete createInfo;
-                _charCreateCallback.Reset();
+                _charCreateInfo.reset();
                 return;
             }
 
@@ -645,11 +718,10 @@ void WorldSession::HandleCharCreateCallback(PreparedQueryResult result, Characte
 
             TC_LOG_INFO("entities.player.character", "Account: %d (IP: %s) Create Character:[%s] (GUID: %u)", GetAccountId(), GetRemoteAddress().c_str(), createInfo->Name.c_str(), newChar.GetGUIDLow());
             sScriptMgr->OnPlayerCreate(&newChar);
-            sWorld->AddCharacterNameData(newChar.GetGUID(), newChar.GetName(), newChar.getGender(), newChar.getRace(), newChar.getClass(), newChar.getLevel());
+            sCharacterCache->AddCharacterCacheEntry(newChar.GetGUID(), GetAccountId(), newChar.GetName(), newChar.getGender(), newChar.getRace(), newChar.getClass(), newChar.getLevel());
 
             newChar.CleanupsBeforeDelete();
-            delete createInfo;
-            _charCreateCallback.Reset();
+            _charCreateInfo.reset();
             break;
         }
     }
@@ -662,6 +734,15 @@ void WorldSession::HandleCharDeleteOpcode(WorldPacket& recvData)
     // Initiating
     uint32 initAccountId = GetAccountId();
 
+    // the login in progress may be loading this character
+    if (PlayerLoading())
+    {
+        SendCharDelete(CHAR_DELETE_FAILED);
+        return;
+    }
+
+    _loginPrefetch.reset();
+
     // can't delete loaded character
     if (ObjectAccessor::FindPlayer(guid))
     {
@@ -749,6 +830,22 @@ void WorldSession::HandlePlayerLoginOpcode(WorldPacket& recvData)
         return;
     }
 
+    if (_loginPrefetch && _loginPrefetch->Guid == playerGuid &&
+        GetMSTimeDiffToNow(_loginPrefetch->Time) < sWorld->getIntConfig(CONFIG_CHARACTER_LOGIN_PREFETCH_TIMEOUT))
+    {
+        if (LoginQueryHolder* holder = _loginPrefetch->Holder)
+        {
+            _loginPrefetch->Holder = NULL;
+            _loginPrefetch.reset();
+            HandlePlayerLogin(holder);
+        }
+        else
+            _loginPrefetch->LoginRequested = true;
+        return;
+    }
+
+    _loginPrefetch.reset();
+
     LoginQueryHolder *holder = new LoginQueryHolder(GetAccountId(), playerGuid);
     if (!holder->Initialize())
     {
@@ -757,7 +854,7 @@ void WorldSession::HandlePlayerLoginOpcode(WorldPacket& recvData)
         return;
     }
 
-    _charLoginCallback = CharacterDatabase.DelayQueryHolder(holder);
+    CharacterDatabase.DelayQueryHolder(holder, _queryCompletionQueue, [this](SQLQueryHolder* result) { HandlePlayerLogin(static_cast<LoginQueryHolder*>(result)); });
 }
 
 void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
@@ -1128,9 +1225,8 @@ void WorldSession::HandleCharRenameOpcode(WorldPacket& recvData)
     stmt->setUInt16(3, AT_LOGIN_RENAME);
     stmt->setString(4, renameInfo.Name);
 
-    delete _charRenameCallback.GetParam();
-    _charRenameCallback.SetParam(new CharacterRenameInfo(std::move(renameInfo)));
-    _charRenameCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+    std::shared_ptr<CharacterRenameInfo> info = std::make_shared<CharacterRenameInfo>(std::move(renameInfo));
+    CharacterDatabase.AsyncQuery(stmt, _queryCompletionQueue, [this, info](PreparedQueryResult result) { HandleChangePlayerNameOpcodeCallBack(result, info.get()); });
 }
 
 void WorldSession::HandleChangePlayerNameOpcodeCallBack(PreparedQueryResult result, CharacterRenameInfo const* renameInfo)
@@ -1166,7 +1262,7 @@ void WorldSession::HandleChangePlayerNameOpcodeCallBack(PreparedQueryResult resu
 
     SendCharRename(RESPONSE_SUCCESS, *renameInfo);
 
-    sWorld->UpdateCharacterNameData(renameInfo->Guid, renameInfo->Name);
+    sCharacterCache->UpdateCharacterData(renameInfo->Guid, renameInfo->Name);
 }
 
 void WorldSession::HandleSetPlayerDeclinedNames(WorldPacket& recvData)
@@ -1175,6 +1271,15 @@ void WorldSession::HandleSetPlayerDeclinedNames(WorldPacket& recvData)
 
     recvData >> guid;
 
+    // declined names are part of the login data, the login in progress may already have read them
+    if (PlayerLoading())
+    {
+        SendSetPlayerDeclinedNamesResult(DECLINED_NAMES_RESULT_ERROR, guid);
+        return;
+    }
+
+    _loginPrefetch.reset();
+
     // not accept declined names for unsupported languages
     std::string name;
     if (!sObjectMgr->GetPlayerNameByGUID(guid, name))
@@ -1456,7 +1561,7 @@ void WorldSession::HandleCharCustomize(WorldPacket& recvData)
 
     CharacterDatabase.CommitTransaction(trans);
 
-    sWorld->UpdateCharacterNameData(customizeInfo.Guid, customizeInfo.Name, customizeInfo.Gender);
+    sCharacterCache->UpdateCharacterData(customizeInfo.Guid, customizeInfo.Name, customizeInfo.Gender);
 
     SendCharCustomize(RESPONSE_SUCCESS, customizeInfo);
 }
@@ -1605,16 +1710,16 @@ void WorldSession::HandleCharFactionOrRaceChange(WorldPacket& recvData)
     uint32 lowGuid = factionChangeInfo.Guid.GetCounter();
 
     // get the players old (at this moment current) race
-    CharacterNameData const* nameData = sWorld->GetCharacterNameData(factionChangeInfo.Guid);
-    if (!nameData)
+    CharacterCacheEntry cacheEntry;
+    if (!sCharacterCache->GetCharacterCacheByGuid(factionChangeInfo.Guid, cacheEntry))
     {
         SendCharFactionChange(CHAR_CREATE_ERROR, factionChangeInfo);
         return;
     }
 
-    uint8 oldRace = nameData->m_race;
-    uint8 playerClass = nameData->m_class;
-    uint8 level = nameData->m_level;
+    uint8 oldRace = cacheEntry.Race;
+    uint8 playerClass = cacheEntry.Class;
+    uint8 level = cacheEntry.Level;
 
     // TO Do: Make async
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_AT_LOGIN_TITLES);
@@ -1704,7 +1809,7 @@ void WorldSession::HandleCharFactionOrRaceChange(WorldPacket& recvData)
     stmt->setUInt32(0, lowGuid);
     trans->Append(stmt);
 
-    sWorld->UpdateCharacterNameData(factionChangeInfo.Guid, factionChangeInfo.Name, factionChangeInfo.Gender, factionChangeInfo.Race);
+    sCharacterCache->UpdateCharacterData(factionChangeInfo.Guid, factionChangeInfo.Name, factionChangeInfo.Gender, factionChangeInfo.Race);
 
     if (oldRace != factionChangeInfo.Race)
     {
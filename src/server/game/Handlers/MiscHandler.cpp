@@ -595,8 +595,7 @@ void WorldSession::HandleAddFriendOpcode(WorldPacket& recvData)
 
     stmt->setString(0, friendName);
 
-    _addFriendCallback.SetParam(friendNote);
-    _addFriendCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+    CharacterDatabase.AsyncQuery(stmt, _queryCompletionQueue, [this, friendNote](PreparedQueryResult result) { HandleAddFriendOpcodeCallBack(result, friendNote); });
 }
 
 void WorldSession::HandleAddFriendOpcodeCallBack(PreparedQueryResult result, std::string const& friendNote)
@@ -685,7 +684,7 @@ void WorldSession::HandleAddIgnoreOpcode(WorldPacket& recvData)
 
     stmt->setString(0, ignoreName);
 
-    _addIgnoreCallback = CharacterDatabase.AsyncQuery(stmt);
+    CharacterDatabase.AsyncQuery(stmt, _queryCompletionQueue, [this](PreparedQueryResult result) { HandleAddIgnoreOpcodeCallBack(result); });
 }
 
 void WorldSession::HandleAddIgnoreOpcodeCallBack(PreparedQueryResult result)
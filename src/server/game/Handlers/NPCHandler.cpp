@@ -498,8 +498,7 @@ void WorldSession::SendStablePet(ObjectGuid guid)
     stmt->setUInt8(1, PET_SAVE_FIRST_STABLE_SLOT);
     stmt->setUInt8(2, PET_SAVE_LAST_STABLE_SLOT);
 
-    _sendStabledPetCallback.SetParam(guid);
-    _sendStabledPetCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+    CharacterDatabase.AsyncQuery(stmt, _queryCompletionQueue, [this, guid](PreparedQueryResult result) { SendStablePetCallback(result, guid); });
 }
 
 void WorldSession::SendStablePetCallback(PreparedQueryResult result, ObjectGuid guid)
@@ -600,7 +599,7 @@ void WorldSession::HandleStablePet(WorldPacket& recvData)
     stmt->setUInt8(1, PET_SAVE_FIRST_STABLE_SLOT);
     stmt->setUInt8(2, PET_SAVE_LAST_STABLE_SLOT);
 
-    _stablePetCallback = CharacterDatabase.AsyncQuery(stmt);
+    CharacterDatabase.AsyncQuery(stmt, _queryCompletionQueue, [this](PreparedQueryResult result) { HandleStablePetCallback(result); });
 }
 
 void WorldSession::HandleStablePetCallback(PreparedQueryResult result)
@@ -662,8 +661,7 @@ void WorldSession::HandleUnstablePet(WorldPacket& recvData)
     stmt->setUInt8(2, PET_SAVE_FIRST_STABLE_SLOT);
     stmt->setUInt8(3, PET_SAVE_LAST_STABLE_SLOT);
 
-    _unstablePetCallback.SetParam(petnumber);
-    _unstablePetCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+    CharacterDatabase.AsyncQuery(stmt, _queryCompletionQueue, [this, petnumber](PreparedQueryResult result) { HandleUnstablePetCallback(result, petnumber); });
 }
 
 void WorldSession::HandleUnstablePetCallback(PreparedQueryResult result, uint32 petId)
@@ -789,8 +787,7 @@ void WorldSession::HandleStableSwapPet(WorldPacket& recvData)
     stmt->setUInt32(0, _player->GetGUIDLow());
     stmt->setUInt32(1, petId);
 
-    _stableSwapCallback.SetParam(petId);
-    _stableSwapCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+    CharacterDatabase.AsyncQuery(stmt, _queryCompletionQueue, [this, petId](PreparedQueryResult result) { HandleStableSwapPetCallback(result, petId); });
 }
 
 void WorldSession::HandleStableSwapPetCallback(PreparedQueryResult result, uint32 petId)
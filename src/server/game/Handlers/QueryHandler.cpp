@@ -24,6 +24,7 @@
 #include "Log.h"
 #include "World.h"
 #include "ObjectMgr.h"
+#include "CharacterCache.h"
 #include "Player.h"
 #include "UpdateMask.h"
 #include "NPCHandler.h"
@@ -32,11 +33,11 @@
 void WorldSession::SendNameQueryOpcode(ObjectGuid guid)
 {
     Player* player = ObjectAccessor::FindConnectedPlayer(guid);
-    CharacterNameData const* nameData = sWorld->GetCharacterNameData(guid);
+    CharacterCacheEntry nameData;
 
     WorldPacket data(SMSG_NAME_QUERY_RESPONSE, (8+1+1+1+1+1+10));
     data << guid.WriteAsPacked();
-    if (!nameData)
+    if (!sCharacterCache->GetCharacterCacheByGuid(guid, nameData))
     {
         data << uint8(1);                           // name unknown
         SendPacket(&data);
@@ -44,11 +45,11 @@ void WorldSession::SendNameQueryOpcode(ObjectGuid guid)
     }
 
     data << uint8(0);                               // name known
-    data << nameData->m_name;                       // played name
+    data << nameData.Name;                          // played name
     data << uint8(0);                               // realm name - only set for cross realm interaction (such as Battlegrounds)
-    data << uint8(nameData->m_race);
-    data << uint8(nameData->m_gender);
-    data << uint8(nameData->m_class);
+    data << uint8(nameData.Race);
+    data << uint8(nameData.Sex);
+    data << uint8(nameData.Class);
 
     if (DeclinedName const* names = (player ? player->GetDeclinedNames() : NULL))
     {
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LineOfSightCache.h"
+#include <cmath>
+
+std::atomic<uint64> LineOfSightCache::_hits(0);
+std::atomic<uint64> LineOfSightCache::_misses(0);
+
+bool LineOfSightCache::Key::operator==(Key const& right) const
+{
+    return Start[0] == right.Start[0] && Start[1] == right.Start[1] && Start[2] == right.Start[2] &&
+        End[0] == right.End[0] && End[1] == right.End[1] && End[2] == right.End[2] &&
+        PhaseMask == right.PhaseMask;
+}
+
+size_t LineOfSightCache::KeyHash::operator()(Key const& key) const
+{
+    size_t hash = key.PhaseMask;
+    for (uint8 i = 0; i < 3; ++i)
+    {
+        hash = hash * 31 + std::hash<int32>()(key.Start[i]);
+        hash = hash * 31 + std::hash<int32>()(key.End[i]);
+    }
+
+    return hash;
+}
+
+LineOfSightCache::Key LineOfSightCache::MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask)
+{
+    Key key;
+    key.Start[0] = int32(std::floor(x1 / LOS_CACHE_PRECISION));
+    key.Start[1] = int32(std::floor(y1 / LOS_CACHE_PRECISION));
+    key.Start[2] = int32(std::floor(z1 / LOS_CACHE_PRECISION));
+    key.End[0] = int32(std::floor(x2 / LOS_CACHE_PRECISION));
+    key.End[1] = int32(std::floor(y2 / LOS_CACHE_PRECISION));
+    key.End[2] = int32(std::floor(z2 / LOS_CACHE_PRECISION));
+    key.PhaseMask = phasemask;
+    return key;
+}
+
+bool LineOfSightCache::Find(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, bool& result)
+{
+    Key key = MakeKey(x1, y1, z1, x2, y2, z2, phasemask);
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto itr = _results.find(key);
+    if (itr == _results.end())
+    {
+        ++_misses;
+        return false;
+    }
+
+    ++_hits;
+    result = itr->second;
+    return true;
+}
+
+void LineOfSightCache::Insert(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, bool result)
+{
+    Key key = MakeKey(x1, y1, z1, x2, y2, z2, phasemask);
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    if (_results.size() >= LOS_CACHE_MAX_ENTRIES)
+        _results.clear();
+
+    _results[key] = result;
+}
+
+void LineOfSightCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _results.clear();
+}
+
+LineOfSightCacheStats LineOfSightCache::GetStats()
+{
+    LineOfSightCacheStats stats;
+    stats.Hits = _hits;
+    stats.Misses = _misses;
+    return stats;
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LINE_OF_SIGHT_CACHE_H
+#define _LINE_OF_SIGHT_CACHE_H
+
+#include "Define.h"
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#define LOS_CACHE_PRECISION     0.5f    // yards, lines with ends closer than this share their result
+#define LOS_CACHE_LIFETIME      200     // ms, a result is never older than this
+#define LOS_CACHE_MAX_ENTRIES   32768   // the cache is cleared early beyond this
+
+struct LineOfSightCacheStats
+{
+    uint64 Hits;
+    uint64 Misses;
+};
+
+/*
+ * Line of sight results of one map for a short time, by rounded ends and phase mask. AI, spells and grid
+ * notifiers ask for the same lines many times per update. Must be cleared whenever the static or dynamic
+ * collision of the map changes, Map does it on vmap tile changes and game object collision changes.
+ */
+class LineOfSightCache
+{
+    struct Key
+    {
+        int32 Start[3];
+        int32 End[3];
+        uint32 PhaseMask;
+
+        bool operator==(Key const& right) const;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(Key const& key) const;
+    };
+
+    public:
+        LineOfSightCache() { }
+
+        // false if there is no result for the line
+        bool Find(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, bool& result);
+        void Insert(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, bool result);
+        void Clear();
+
+        static LineOfSightCacheStats GetStats();
+
+    private:
+        static Key MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask);
+
+        // commands ask from the world thread
+        std::mutex _lock;
+        std::unordered_map<Key, bool, KeyHash> _results;
+
+        static std::atomic<uint64> _hits;
+        static std::atomic<uint64> _misses;
+
+        LineOfSightCache(LineOfSightCache const&) = delete;
+        LineOfSightCache& operator=(LineOfSightCache const&) = delete;
+};
+
+#endif
@@ -22,6 +22,8 @@
 #include "CellImpl.h"
 #include "DisableMgr.h"
 #include "DynamicTree.h"
+#include "FlowField.h"
+#include "MoveSpline.h"
 #include "GridNotifiers.h"
 #include "GridNotifiersImpl.h"
 #include "GridStates.h"
@@ -32,6 +34,7 @@
 #include "ObjectMgr.h"
 #include "Pet.h"
 #include "ScriptMgr.h"
+#include "TilePrefetcher.h"
 #include "Transport.h"
 #include "Vehicle.h"
 #include "VMapFactory.h"
@@ -143,6 +146,7 @@ void Map::LoadVMap(int gx, int gy)
         return;
                                                             // x and y are swapped !!
     int vmapLoadResult = VMAP::VMapFactory::createOrGetVMapManager()->loadMap((sWorld->GetDataPath()+ "vmaps").c_str(),  GetId(), gx, gy);
+    ClearLineOfSightCache();
     switch (vmapLoadResult)
     {
         case VMAP::VMAP_LOAD_RESULT_OK:
@@ -192,15 +196,70 @@ void Map::LoadMap(int gx, int gy, bool reload)
     tmp = new char[len];
     snprintf(tmp, len, (char *)(sWorld->GetDataPath() + "maps/%03u%02u%02u.map").c_str(), GetId(), gx, gy);
     TC_LOG_DEBUG("maps", "Loading map %s", tmp);
+    // loaded ahead by the prefetcher, unless the file has to be read again
+    if (!reload)
+        GridMaps[gx][gy] = sTilePrefetcher->TakeGridMap(GetId(), gx, gy);
+
     // loading data
-    GridMaps[gx][gy] = new GridMap();
-    if (!GridMaps[gx][gy]->loadData(tmp))
-        TC_LOG_ERROR("maps", "Error loading map file: \n %s\n", tmp);
+    if (!GridMaps[gx][gy])
+    {
+        GridMaps[gx][gy] = new GridMap();
+        if (!GridMaps[gx][gy]->loadData(tmp))
+            TC_LOG_ERROR("maps", "Error loading map file: \n %s\n", tmp);
+    }
     delete[] tmp;
 
     sScriptMgr->OnLoadGridMap(this, GridMaps[gx][gy], gx, gy);
 }
 
+void Map::PrefetchGridsAhead(Player const* player)
+{
+    if (player->movespline->onTransport)
+        return;
+
+    // on taxis the next points of the flight path
+    if (player->IsInFlight() && !player->movespline->Finalized())
+    {
+        Movement::MoveSpline::MySpline const& spline = player->movespline->_Spline();
+        float maxDist = player->GetSpeed(MOVE_FLIGHT) * TILE_PREFETCH_LOOKAHEAD;
+        for (int32 i = player->movespline->_currentSplineIdx() + 1; i <= spline.last(); ++i)
+        {
+            G3D::Vector3 const& point = spline.getPoint(i);
+            if (player->GetExactDist2dSq(point.x, point.y) > maxDist * maxDist)
+                break;
+
+            PrefetchGrid(point.x, point.y);
+        }
+        return;
+    }
+
+    if (!player->isMoving())
+        return;
+
+    // straight ahead at current speed, half a grid apart so no grid on the way is skipped
+    float maxDist = player->GetSpeed(player->IsFlying() ? MOVE_FLIGHT : MOVE_RUN) * TILE_PREFETCH_LOOKAHEAD;
+    float angle = player->GetOrientation();
+    for (float dist = SIZE_OF_GRIDS / 2; dist <= maxDist; dist += SIZE_OF_GRIDS / 2)
+        PrefetchGrid(player->GetPositionX() + dist * std::cos(angle), player->GetPositionY() + dist * std::sin(angle));
+}
+
+void Map::PrefetchGrid(float x, float y)
+{
+    GridCoord p = Trinity::ComputeGridCoord(x, y);
+    if (!p.IsCoordValid())
+        return;
+
+    int gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+    int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+
+    // instances share the terrain of their base map, a stale read only costs a useless prefetch
+    Map const* baseMap = i_InstanceId ? m_parentMap : this;
+    if (baseMap->GridMaps[gx][gy])
+        return;
+
+    sTilePrefetcher->Prefetch(GetId(), gx, gy);
+}
+
 void Map::LoadMapAndVMap(int gx, int gy)
 {
     LoadMap(gx, gy);
@@ -231,11 +290,11 @@ void Map::DeleteStateMachine()
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _parent):
 _creatureToMoveLock(false), _gameObjectsToMoveLock(false), _dynamicObjectsToMoveLock(false),
 i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
-m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
+m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), _lineOfSightCacheTimer(LOS_CACHE_LIFETIME),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
 i_gridExpiry(expiry),
-i_scriptLock(false), _defaultLight(GetDefaultMapLight(id))
+i_scriptLock(false), _defaultLight(GetDefaultMapLight(id)), _prefetchTimer(TILE_PREFETCH_INTERVAL)
 {
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -631,6 +690,15 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
 void Map::Update(const uint32 t_diff)
 {
     _dynamicTree.update(t_diff);
+
+    // transports and elevators move their models without leaving the tree
+    _lineOfSightCacheTimer.Update(t_diff);
+    if (_lineOfSightCacheTimer.Passed())
+    {
+        _lineOfSightCacheTimer.Reset(LOS_CACHE_LIFETIME);
+        ClearLineOfSightCache();
+    }
+
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
@@ -643,6 +711,19 @@ void Map::Update(const uint32 t_diff)
             session->Update(t_diff, updater);
         }
     }
+
+    if (sTilePrefetcher->IsActive())
+    {
+        _prefetchTimer.Update(t_diff);
+        if (_prefetchTimer.Passed())
+        {
+            _prefetchTimer.Reset(TILE_PREFETCH_INTERVAL);
+            for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+                if (Player* player = m_mapRefIter->GetSource())
+                    if (player->IsInWorld())
+                        PrefetchGridsAhead(player);
+        }
+    }
     /// update active cells around players and active objects
     resetMarkedCells();
 
@@ -707,6 +788,8 @@ void Map::Update(const uint32 t_diff)
         i_scriptLock = false;
     }
 
+    UpdateAllSplinePositions();
+
     MoveAllCreaturesInMoveList();
     MoveAllGameObjectsInMoveList();
 
@@ -1036,6 +1119,26 @@ void Map::RemoveCreatureFromMoveList(Creature* c)
         c->_moveState = MAP_OBJECT_CELL_MOVE_INACTIVE;
 }
 
+void Map::AddUnitToSplineUpdateList(Unit* unit)
+{
+    _unitsToUpdateSpline.push_back(unit);
+}
+
+void Map::RemoveUnitFromSplineUpdateList(Unit* unit)
+{
+    _unitsToUpdateSpline.erase(std::remove(_unitsToUpdateSpline.begin(), _unitsToUpdateSpline.end(), unit), _unitsToUpdateSpline.end());
+}
+
+void Map::UpdateAllSplinePositions()
+{
+    // units leaving the world are taken out of the list, but not out of this copy of it
+    std::vector<Unit*> units;
+    units.swap(_unitsToUpdateSpline);
+
+    for (std::vector<Unit*>::iterator itr = units.begin(); itr != units.end(); ++itr)
+        (*itr)->UpdateQueuedSplinePosition();
+}
+
 void Map::AddGameObjectToMoveList(GameObject* go, float x, float y, float z, float ang)
 {
     if (_gameObjectsToMoveLock) //can this happen?
@@ -1520,6 +1623,7 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
             }
             VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(GetId(), gx, gy);
             MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId(), gx, gy);
+            ClearLineOfSightCache();
         }
         else
             ((MapInstanced*)m_parentMap)->RemoveGridMapReference(GridCoord(gx, gy));
@@ -1550,6 +1654,7 @@ void Map::RemoveAllPlayers()
 void Map::UnloadAll()
 {
     // clear all delayed moves, useless anyway do this moves before map unload.
+    _unitsToUpdateSpline.clear();
     _creaturesToMove.clear();
     _gameObjectsToMove.clear();
 
@@ -1594,6 +1699,8 @@ GridMap::GridMap()
     _liquidEntry = NULL;
     _liquidFlags = NULL;
     _liquidMap  = NULL;
+    _liquidIntHeight = 0;
+    _liquidIntHeightMultiplier = 0;
 }
 
 GridMap::~GridMap()
@@ -1665,6 +1772,7 @@ void GridMap::unloadData()
     _liquidEntry = NULL;
     _liquidFlags = NULL;
     _liquidMap  = NULL;
+    _flags = 0;
     _gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
@@ -1725,6 +1833,8 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
                 fread(m_V8, sizeof(float), 128*128, in) != 128*128)
                 return false;
             _gridGetHeight = &GridMap::getHeightFromFloat;
+            if (sWorld->getBoolConfig(CONFIG_GRID_PACK_FLOAT_HEIGHTS))
+                packHeightData();
         }
     }
     else
@@ -1762,10 +1872,103 @@ bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
         _liquidMap = new float[uint32(_liquidWidth) * uint32(_liquidHeight)];
         if (fread(_liquidMap, sizeof(float), _liquidWidth*_liquidHeight, in) != (uint32(_liquidWidth) * uint32(_liquidHeight)))
             return false;
+        packLiquidData();
     }
     return true;
 }
 
+template<typename T>
+static T* PackHeights(float const* heights, uint32 count, float minHeight, float step)
+{
+    T* packed = new T[count];
+    for (uint32 i = 0; i < count; ++i)
+        packed[i] = T((heights[i] - minHeight) * step + 0.5f);
+    return packed;
+}
+
+void GridMap::packHeightData()
+{
+    float minHeight = std::min(*std::min_element(m_V9, m_V9 + 129*129), *std::min_element(m_V8, m_V8 + 128*128));
+    float maxHeight = std::max(*std::max_element(m_V9, m_V9 + 129*129), *std::max_element(m_V8, m_V8 + 128*128));
+    float diff = maxHeight - minHeight;
+
+    float* V9 = m_V9;
+    float* V8 = m_V8;
+    if (diff == 0.0f)
+    {
+        m_V9 = NULL;
+        m_V8 = NULL;
+        _gridHeight = minHeight;
+        _gridGetHeight = &GridMap::getHeightFromFlat;
+    }
+    else if (diff < GRIDMAP_PACK_INT8_LIMIT)
+    {
+        m_uint8_V9 = PackHeights<uint8>(V9, 129*129, minHeight, 255 / diff);
+        m_uint8_V8 = PackHeights<uint8>(V8, 128*128, minHeight, 255 / diff);
+        _gridHeight = minHeight;
+        _gridIntHeightMultiplier = diff / 255;
+        _gridGetHeight = &GridMap::getHeightFromUint8;
+    }
+    else if (diff < GRIDMAP_PACK_INT16_LIMIT)
+    {
+        m_uint16_V9 = PackHeights<uint16>(V9, 129*129, minHeight, 65535 / diff);
+        m_uint16_V8 = PackHeights<uint16>(V8, 128*128, minHeight, 65535 / diff);
+        _gridHeight = minHeight;
+        _gridIntHeightMultiplier = diff / 65535;
+        _gridGetHeight = &GridMap::getHeightFromUint16;
+    }
+    else
+        return;
+
+    delete[] V9;
+    delete[] V8;
+}
+
+void GridMap::packLiquidData()
+{
+    uint32 count = uint32(_liquidWidth) * uint32(_liquidHeight);
+    if (!count)
+        return;
+
+    // cells without liquid are stored at the extractor's minimum height, they count for the range
+    float minHeight = *std::min_element(_liquidMap, _liquidMap + count);
+    float maxHeight = *std::max_element(_liquidMap, _liquidMap + count);
+    float diff = maxHeight - minHeight;
+
+    float* liquidMap = _liquidMap;
+    if (diff == 0.0f)
+    {
+        _liquidMap = NULL;
+        _liquidLevel = minHeight;
+    }
+    else if (diff < GRIDMAP_PACK_INT8_LIMIT)
+    {
+        _liquidMapUint8 = PackHeights<uint8>(liquidMap, count, minHeight, 255 / diff);
+        _liquidIntHeightMultiplier = diff / 255;
+        _flags |= GRIDMAP_LIQUID_AS_INT8;
+    }
+    else if (diff < GRIDMAP_PACK_INT16_LIMIT)
+    {
+        _liquidMapUint16 = PackHeights<uint16>(liquidMap, count, minHeight, 65535 / diff);
+        _liquidIntHeightMultiplier = diff / 65535;
+        _flags |= GRIDMAP_LIQUID_AS_INT16;
+    }
+    else
+        return;
+
+    _liquidIntHeight = minHeight;
+    delete[] liquidMap;
+}
+
+float GridMap::getLiquidMapLevel(uint32 index) const
+{
+    if (_flags & GRIDMAP_LIQUID_AS_INT8)
+        return (float)_liquidMapUint8[index] * _liquidIntHeightMultiplier + _liquidIntHeight;
+    if (_flags & GRIDMAP_LIQUID_AS_INT16)
+        return (float)_liquidMapUint16[index] * _liquidIntHeightMultiplier + _liquidIntHeight;
+    return _liquidMap[index];
+}
+
 uint16 GridMap::getArea(float x, float y) const
 {
     if (!_areaMap)
@@ -2015,7 +2218,7 @@ float GridMap::getLiquidLevel(float x, float y) const
     if (cy_int < 0 || cy_int >=_liquidWidth)
         return INVALID_HEIGHT;
 
-    return _liquidMap[cx_int*_liquidWidth + cy_int];
+    return getLiquidMapLevel(cx_int*_liquidWidth + cy_int);
 }
 
 // Why does this return LIQUID data?
@@ -2097,7 +2300,7 @@ inline ZLiquidStatus GridMap::getLiquidStatus(float x, float y, float z, uint8 R
         return LIQUID_MAP_NO_WATER;
 
     // Get water level
-    float liquid_level = _liquidMap ? _liquidMap[lx_int*_liquidWidth + ly_int] : _liquidLevel;
+    float liquid_level = _liquidMap ? getLiquidMapLevel(lx_int*_liquidWidth + ly_int) : _liquidLevel;
     // Get ground level (sub 0.2 for fix some errors)
     float ground_level = getHeight(x, y);
 
@@ -2431,8 +2634,29 @@ void Map::GetZoneAndAreaIdByAreaFlag(uint32& zoneid, uint32& areaid, uint16 area
 
 bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2)
+    bool result;
+    if (_lineOfSightCache.Find(x1, y1, z1, x2, y2, z2, phasemask, result))
+        return result;
+
+    result = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2)
         && _dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask);
+
+    _lineOfSightCache.Insert(x1, y1, z1, x2, y2, z2, phasemask, result);
+    return result;
+}
+
+void Map::isInLineOfSight(float x, float y, float z, G3D::Vector3 const* targets, uint32 count, uint32 phasemask, bool* results) const
+{
+    // the static tree is walked once for all lines
+    VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x, y, z, targets, count, results);
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (results[i])
+            results[i] = _dynamicTree.isInLineOfSight(x, y, z, targets[i].x, targets[i].y, targets[i].z, phasemask);
+
+        _lineOfSightCache.Insert(x, y, z, targets[i].x, targets[i].y, targets[i].z, phasemask, results[i]);
+    }
 }
 
 bool Map::getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
@@ -3565,3 +3789,23 @@ void Map::UpdateAreaDependentAuras()
                 player->UpdateZoneDependentAuras(player->GetZoneId());
             }
 }
+
+std::shared_ptr<FlowField> Map::GetFlowField(Unit const* target, uint16 includeFlags)
+{
+    std::weak_ptr<FlowField>& entry = _flowFields[std::make_pair(target->GetGUID(), includeFlags)];
+    if (std::shared_ptr<FlowField> field = entry.lock())
+        return field;
+
+    // fields of targets nobody chases anymore
+    for (FlowFieldContainer::iterator itr = _flowFields.begin(); itr != _flowFields.end();)
+    {
+        if (itr->second.expired() && &itr->second != &entry)
+            itr = _flowFields.erase(itr);
+        else
+            ++itr;
+    }
+
+    std::shared_ptr<FlowField> field = std::make_shared<FlowField>(target->GetGUID(), includeFlags);
+    entry = field;
+    return field;
+}
@@ -30,10 +30,12 @@
 #include "MapRefManager.h"
 #include "DynamicTree.h"
 #include "GameObjectModel.h"
+#include "LineOfSightCache.h"
 #include "ObjectGuid.h"
 
 #include <bitset>
 #include <list>
+#include <memory>
 
 class Unit;
 class WorldPacket;
@@ -53,6 +55,7 @@ class MapInstanced;
 class BattlegroundMap;
 class InstanceMap;
 class Transport;
+class FlowField;
 namespace Trinity { struct ObjectUpdater; }
 
 struct ScriptAction
@@ -152,6 +155,14 @@ struct LiquidData
     float  depth_level;
 };
 
+// liquid levels, and float heights if GridPackFloatHeights is enabled, are packed on load like map_extractor
+// packs heights, when their range is within its CONF_float_to_int8_limit and CONF_float_to_int16_limit
+#define GRIDMAP_PACK_INT8_LIMIT     2.0f
+#define GRIDMAP_PACK_INT16_LIMIT    2048.0f
+
+#define GRIDMAP_LIQUID_AS_INT16     0x0001
+#define GRIDMAP_LIQUID_AS_INT8      0x0002
+
 class GridMap
 {
     uint32  _flags;
@@ -176,7 +187,13 @@ class GridMap
     float _liquidLevel;
     uint16* _liquidEntry;
     uint8* _liquidFlags;
-    float* _liquidMap;
+    union{
+        float* _liquidMap;
+        uint16* _liquidMapUint16;
+        uint8* _liquidMapUint8;
+    };
+    float _liquidIntHeight;
+    float _liquidIntHeightMultiplier;
     uint16 _gridArea;
     uint16 _liquidType;
     uint8 _liquidOffX;
@@ -188,6 +205,9 @@ class GridMap
     bool loadAreaData(FILE* in, uint32 offset, uint32 size);
     bool loadHeightData(FILE* in, uint32 offset, uint32 size);
     bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
+    void packHeightData();
+    void packLiquidData();
+    float getLiquidMapLevel(uint32 index) const;
 
     // Get height functions and pointers
     typedef float (GridMap::*GetHeightPtr) (float x, float y) const;
@@ -370,6 +390,11 @@ class Map : public GridRefManager<NGridType>
         void MoveAllGameObjectsInMoveList();
         void MoveAllDynamicObjectsInMoveList();
         void RemoveAllObjectsInRemoveList();
+
+        // positions of moving units are written back together after the object updates
+        void AddUnitToSplineUpdateList(Unit* unit);
+        void RemoveUnitFromSplineUpdateList(Unit* unit);
+        void UpdateAllSplinePositions();
         virtual void RemoveAllPlayers();
 
         // used only in MoveAllCreaturesInMoveList and ObjectGridUnloader
@@ -469,10 +494,15 @@ class Map : public GridRefManager<NGridType>
         float GetWaterOrGroundLevel(float x, float y, float z, float* ground = NULL, bool swim = false) const;
         float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const;
+        // line of sight from one position to count targets at once, results[i] is the result for targets[i]
+        void isInLineOfSight(float x, float y, float z, G3D::Vector3 const* targets, uint32 count, uint32 phasemask, bool* results) const;
+        void ClearLineOfSightCache() { _lineOfSightCache.Clear(); }
         void Balance() { _dynamicTree.balance(); }
-        void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
-        void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); }
+        void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); ClearLineOfSightCache(); }
+        void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); ClearLineOfSightCache(); }
         bool ContainsGameObjectModel(const GameObjectModel& model) const { return _dynamicTree.contains(model);}
+        // moving transports do this every update, line of sight results through them age out with the cache
+        void RelocateGameObjectModel(const GameObjectModel& model) { _dynamicTree.relocate(model); }
         bool getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist);
 
         /*
@@ -516,6 +546,9 @@ class Map : public GridRefManager<NGridType>
 
         void UpdateAreaDependentAuras();
 
+        // field shared by all units moving to target with the same navmesh filter, built on first use
+        std::shared_ptr<FlowField> GetFlowField(Unit const* target, uint16 includeFlags);
+
     private:
         void LoadMapAndVMap(int gx, int gy);
         void LoadVMap(int gx, int gy);
@@ -523,6 +556,10 @@ class Map : public GridRefManager<NGridType>
         void LoadMMap(int gx, int gy);
         GridMap* GetGrid(float x, float y);
 
+        // queue the tiles of grids the player will reach within TILE_PREFETCH_LOOKAHEAD for the TilePrefetcher
+        void PrefetchGridsAhead(Player const* player);
+        void PrefetchGrid(float x, float y);
+
         void SetTimer(uint32 t) { i_gridExpiry = t < MIN_GRID_DELAY ? MIN_GRID_DELAY : t; }
 
         void SendInitSelf(Player* player);
@@ -548,6 +585,8 @@ class Map : public GridRefManager<NGridType>
         bool _dynamicObjectsToMoveLock;
         std::vector<DynamicObject*> _dynamicObjectsToMove;
 
+        std::vector<Unit*> _unitsToUpdateSpline;
+
         bool IsGridLoaded(const GridCoord &) const;
         void EnsureGridCreated(const GridCoord &);
         void EnsureGridCreated_i(const GridCoord &);
@@ -582,6 +621,8 @@ class Map : public GridRefManager<NGridType>
         uint32 m_unloadTimer;
         float m_VisibleDistance;
         DynamicMapTree _dynamicTree;
+        mutable LineOfSightCache _lineOfSightCache;
+        TimeTrackerSmall _lineOfSightCacheTimer;
 
         MapRefManager m_mapRefManager;
         MapRefManager::iterator m_mapRefIter;
@@ -662,6 +703,12 @@ class Map : public GridRefManager<NGridType>
 
         ZoneDynamicInfoMap _zoneDynamicInfo;
         uint32 _defaultLight;
+
+        TimeTrackerSmall _prefetchTimer;
+
+        // dropped with the last unit using it
+        typedef std::map<std::pair<ObjectGuid, uint16 /*includeFlags*/>, std::weak_ptr<FlowField>> FlowFieldContainer;
+        FlowFieldContainer _flowFields;
 };
 
 enum InstanceResetMethod
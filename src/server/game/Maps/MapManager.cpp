@@ -36,6 +36,8 @@
 #include "WorldSession.h"
 #include "Opcodes.h"
 #include "AchievementMgr.h"
+#include "PathfindingMgr.h"
+#include "TilePrefetcher.h"
 
 MapManager::MapManager()
 {
@@ -63,6 +65,11 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (sWorld->getBoolConfig(CONFIG_ENABLE_MMAPS))
+        sPathfindingMgr->Activate(sWorld->getIntConfig(CONFIG_PATHFINDING_THREADS));
+
+    sTilePrefetcher->Activate(sWorld->getIntConfig(CONFIG_MAP_PREFETCH_THREADS));
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -290,6 +297,12 @@ bool MapManager::IsValidMAP(uint32 mapid, bool startUp)
 
 void MapManager::UnloadAll()
 {
+    if (sPathfindingMgr->IsActive())
+        sPathfindingMgr->Deactivate();
+
+    if (sTilePrefetcher->IsActive())
+        sTilePrefetcher->Deactivate();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end();)
     {
         iter->second->UnloadAll();
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TilePrefetcher.h"
+#include "Log.h"
+#include "Map.h"
+#include "MapTree.h"
+#include "VMapFactory.h"
+#include "World.h"
+#include <algorithm>
+
+void TilePrefetcher::Activate(uint32 threads)
+{
+    for (uint32 i = 0; i < threads; ++i)
+        _workerThreads.push_back(std::thread(&TilePrefetcher::WorkerThread, this));
+
+    if (threads)
+        TC_LOG_INFO("maps", "Started %u tile prefetch threads", threads);
+}
+
+void TilePrefetcher::Deactivate()
+{
+    _cancelationToken = true;
+
+    _queue.Cancel();
+
+    for (auto& thread : _workerThreads)
+        thread.join();
+
+    _workerThreads.clear();
+
+    for (auto itr = _gridMaps.begin(); itr != _gridMaps.end(); ++itr)
+        delete itr->second;
+
+    _gridMaps.clear();
+    _gridMapOrder.clear();
+    _pending.clear();
+}
+
+void TilePrefetcher::Prefetch(uint32 mapId, uint32 gx, uint32 gy)
+{
+    uint32 key = MakeKey(mapId, gx, gy);
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (_pending.count(key) || _gridMaps.count(key))
+            return;
+
+        _pending.insert(key);
+    }
+
+    ++_prefetchCount;
+    _queue.Push(key);
+}
+
+GridMap* TilePrefetcher::TakeGridMap(uint32 mapId, uint32 gx, uint32 gy)
+{
+    uint32 key = MakeKey(mapId, gx, gy);
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto itr = _gridMaps.find(key);
+    if (itr == _gridMaps.end())
+        return NULL;
+
+    GridMap* gridMap = itr->second;
+    _gridMaps.erase(itr);
+    _gridMapOrder.erase(std::find(_gridMapOrder.begin(), _gridMapOrder.end(), key));
+
+    ++_hitCount;
+    return gridMap;
+}
+
+void TilePrefetcher::WorkerThread()
+{
+    while (1)
+    {
+        uint32 key = 0;
+
+        _queue.WaitAndPop(key);
+
+        if (_cancelationToken)
+            return;
+
+        LoadTiles(key);
+    }
+}
+
+void TilePrefetcher::LoadTiles(uint32 key)
+{
+    uint32 mapId = key >> 12;
+    uint32 gx = (key >> 6) & 0x3F;
+    uint32 gy = key & 0x3F;
+
+    std::string const& dataPath = sWorld->GetDataPath();
+    char fileName[32];
+
+    // errors are reported by the map thread, it loads the grid again if this failed
+    snprintf(fileName, sizeof(fileName), "maps/%03u%02u%02u.map", mapId, gx, gy);
+    GridMap* gridMap = new GridMap();
+    if (!gridMap->loadData((dataPath + fileName).c_str()))
+    {
+        delete gridMap;
+        gridMap = NULL;
+    }
+
+    if (VMAP::VMapFactory::createOrGetVMapManager()->isMapLoadingEnabled())
+        ReadFile(dataPath + "vmaps/" + VMAP::StaticMapTree::getTileFileName(mapId, gx, gy));
+
+    if (sWorld->getBoolConfig(CONFIG_ENABLE_MMAPS))
+    {
+        snprintf(fileName, sizeof(fileName), "mmaps/%03u%02u%02u.mmtile", mapId, gx, gy);
+        ReadFile(dataPath + fileName);
+    }
+
+    TC_LOG_DEBUG("maps", "TilePrefetcher: prefetched grid [%u, %u] of map %u", gx, gy, mapId);
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    _pending.erase(key);
+
+    if (!gridMap)
+        return;
+
+    _gridMaps[key] = gridMap;
+    _gridMapOrder.push_back(key);
+
+    // players turned away from these
+    while (_gridMaps.size() > TILE_PREFETCH_MAX_GRIDS)
+    {
+        auto itr = _gridMaps.find(_gridMapOrder.front());
+        delete itr->second;
+        _gridMaps.erase(itr);
+        _gridMapOrder.pop_front();
+    }
+}
+
+void TilePrefetcher::ReadFile(std::string const& fileName)
+{
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return;
+
+    // the content is of no use here, only that the OS has it cached
+    std::vector<char> buffer(64 * 1024);
+    while (fread(buffer.data(), 1, buffer.size(), file) == buffer.size());
+
+    fclose(file);
+}
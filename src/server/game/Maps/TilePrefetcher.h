@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TILE_PREFETCHER_H
+#define _TILE_PREFETCHER_H
+
+#include "Define.h"
+#include "ProducerConsumerQueue.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class GridMap;
+
+#define TILE_PREFETCH_INTERVAL      1000    // ms between two predictions of a map
+#define TILE_PREFETCH_LOOKAHEAD     15.0f   // seconds of movement ahead of a player
+#define TILE_PREFETCH_MAX_GRIDS     64      // prefetched terrain nobody picked up, the oldest is dropped beyond this
+
+/*
+ * Loads the tile data of grids players are about to enter on its own threads, ahead of the map thread.
+ * The terrain (.map) is loaded into a GridMap that Map::LoadMap adopts instead of reading the file.
+ * The .vmtile and .mmtile files of the grid are read once so they are in the page cache when the
+ * map thread loads them, they are linked into the shared vmap and mmap trees there.
+ * Grids are given by the file coordinates of Map::LoadMap.
+ */
+class TilePrefetcher
+{
+    public:
+        static TilePrefetcher* instance()
+        {
+            static TilePrefetcher instance;
+            return &instance;
+        }
+
+        void Activate(uint32 threads);
+        void Deactivate();
+        bool IsActive() const { return !_workerThreads.empty(); }
+
+        // does nothing if the grid is already queued or waiting to be picked up
+        void Prefetch(uint32 mapId, uint32 gx, uint32 gy);
+
+        // the prefetched terrain of the grid, owned by the caller, NULL if it was not prefetched
+        GridMap* TakeGridMap(uint32 mapId, uint32 gx, uint32 gy);
+
+        uint64 GetPrefetchCount() const { return _prefetchCount; }
+        uint64 GetHitCount() const { return _hitCount; }
+
+    private:
+        TilePrefetcher() : _cancelationToken(false), _prefetchCount(0), _hitCount(0) { }
+        ~TilePrefetcher() { }
+
+        static uint32 MakeKey(uint32 mapId, uint32 gx, uint32 gy) { return (mapId << 12) | (gx << 6) | gy; }
+
+        void WorkerThread();
+        void LoadTiles(uint32 key);
+        static void ReadFile(std::string const& fileName);
+
+        ProducerConsumerQueue<uint32> _queue;
+        std::vector<std::thread> _workerThreads;
+        std::atomic<bool> _cancelationToken;
+
+        std::mutex _lock;
+        std::unordered_set<uint32> _pending;                // queued or being loaded
+        std::unordered_map<uint32, GridMap*> _gridMaps;     // loaded, waiting for their map
+        std::deque<uint32> _gridMapOrder;                   // oldest first
+
+        std::atomic<uint64> _prefetchCount;
+        std::atomic<uint64> _hitCount;
+
+        TilePrefetcher(TilePrefetcher const&) = delete;
+        TilePrefetcher& operator=(TilePrefetcher const&) = delete;
+};
+
+#define sTilePrefetcher TilePrefetcher::instance()
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FlowField.h"
+#include "MMapFactory.h"
+#include "MMapManager.h"
+#include "PathGenerator.h"
+#include "Timer.h"
+#include "Unit.h"
+
+std::atomic<uint64> FlowField::_builds(0);
+std::atomic<uint64> FlowField::_lookups(0);
+std::atomic<uint64> FlowField::_misses(0);
+
+FlowField::FlowField(ObjectGuid targetGuid, uint16 includeFlags) : _targetGuid(targetGuid), _navMeshQuery(NULL),
+    _targetPoly(INVALID_POLYREF), _buildTime(0)
+{
+    _filter.setIncludeFlags(includeFlags);
+    _filter.setExcludeFlags(0);
+}
+
+void FlowField::Update(Unit const* target)
+{
+    float point[VERTEX_SIZE] = { target->GetPositionY(), target->GetPositionZ(), target->GetPositionX() };
+
+    if (_targetPoly != INVALID_POLYREF && _navMeshQuery->isValidPolyRef(_targetPoly, &_filter))
+    {
+        if (GetMSTimeDiffToNow(_buildTime) < FLOW_FIELD_REBUILD_DELAY)
+            return;
+
+        if (FindPoly(point) == _targetPoly)
+            return;
+    }
+
+    Build(target, point);
+}
+
+void FlowField::Build(Unit const* target, float const* point)
+{
+    _nextPoly.clear();
+    _buildTime = getMSTime();
+
+    _navMeshQuery = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshQuery(target->GetMapId(), target->GetInstanceId());
+    if (!_navMeshQuery)
+    {
+        _targetPoly = INVALID_POLYREF;
+        return;
+    }
+
+    _targetPoly = FindPoly(point);
+    if (_targetPoly == INVALID_POLYREF)
+        return;
+
+    // the parent of each polygon is the one it was reached from, the target polygon has none
+    dtPolyRef polys[FLOW_FIELD_MAX_POLYS];
+    dtPolyRef parents[FLOW_FIELD_MAX_POLYS];
+    int polyCount = 0;
+    if (dtStatusFailed(_navMeshQuery->findPolysAroundCircle(_targetPoly, point, FLOW_FIELD_RADIUS, &_filter,
+        polys, parents, NULL, &polyCount, FLOW_FIELD_MAX_POLYS)))
+    {
+        _targetPoly = INVALID_POLYREF;
+        return;
+    }
+
+    _nextPoly.reserve(polyCount);
+    for (int i = 0; i < polyCount; ++i)
+        _nextPoly[polys[i]] = parents[i];
+
+    ++_builds;
+}
+
+bool FlowField::BuildPath(G3D::Vector3 const& start, G3D::Vector3 const& dest, Movement::PointsArray& path) const
+{
+    if (_targetPoly == INVALID_POLYREF)
+        return false;
+
+    float startPoint[VERTEX_SIZE] = { start.y, start.z, start.x };
+    float endPoint[VERTEX_SIZE] = { dest.y, dest.z, dest.x };
+
+    std::unordered_map<dtPolyRef, dtPolyRef>::const_iterator itr = _nextPoly.find(FindPoly(startPoint));
+    if (itr == _nextPoly.end())
+    {
+        ++_misses;
+        return false;
+    }
+
+    dtPolyRef corridor[FLOW_FIELD_MAX_CORRIDOR];
+    uint32 corridorSize = 0;
+    corridor[corridorSize++] = itr->first;
+    for (dtPolyRef next = itr->second; next != INVALID_POLYREF && corridorSize < FLOW_FIELD_MAX_CORRIDOR; next = itr->second)
+    {
+        corridor[corridorSize++] = next;
+        itr = _nextPoly.find(next);
+        if (itr == _nextPoly.end())
+            break;
+    }
+
+    // beyond the corridor the end is clamped to its last polygon, the follower asks again once there
+    float points[MAX_POINT_PATH_LENGTH * VERTEX_SIZE];
+    int pointCount = 0;
+    if (dtStatusFailed(_navMeshQuery->findStraightPath(startPoint, endPoint, corridor, corridorSize,
+        points, NULL, NULL, &pointCount, MAX_POINT_PATH_LENGTH)) || pointCount < 2)
+    {
+        ++_misses;
+        return false;
+    }
+
+    path.resize(pointCount);
+    for (int i = 0; i < pointCount; ++i)
+        path[i] = G3D::Vector3(points[i * VERTEX_SIZE + 2], points[i * VERTEX_SIZE], points[i * VERTEX_SIZE + 1]);
+
+    ++_lookups;
+    return true;
+}
+
+dtPolyRef FlowField::FindPoly(float const* point) const
+{
+    // same search boxes as PathGenerator::GetPolyByLocation
+    float extents[VERTEX_SIZE] = { 3.0f, 5.0f, 3.0f };
+    dtPolyRef polyRef = INVALID_POLYREF;
+    if (dtStatusSucceed(_navMeshQuery->findNearestPoly(point, extents, &_filter, &polyRef, NULL)) && polyRef != INVALID_POLYREF)
+        return polyRef;
+
+    extents[1] = 50.0f;
+    if (dtStatusSucceed(_navMeshQuery->findNearestPoly(point, extents, &_filter, &polyRef, NULL)))
+        return polyRef;
+
+    return INVALID_POLYREF;
+}
+
+FlowFieldStats FlowField::GetStats()
+{
+    FlowFieldStats stats;
+    stats.Builds = _builds;
+    stats.Lookups = _lookups;
+    stats.Misses = _misses;
+    return stats;
+}
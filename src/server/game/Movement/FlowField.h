@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _FLOW_FIELD_H
+#define _FLOW_FIELD_H
+
+#include "Define.h"
+#include "DetourNavMeshQuery.h"
+#include "MoveSplineInitArgs.h"
+#include "ObjectGuid.h"
+#include <atomic>
+#include <unordered_map>
+
+class Unit;
+
+#define FLOW_FIELD_RADIUS           60.0f   // yards of navmesh around the target the field covers
+#define FLOW_FIELD_MAX_POLYS        1024    // the node pool of a navmesh query is not larger
+#define FLOW_FIELD_REBUILD_DELAY    250     // ms, the target may leave its polygon more often
+#define FLOW_FIELD_MAX_CORRIDOR     64      // polygons followed towards the target per path
+
+struct FlowFieldStats
+{
+    uint64 Builds;                          // Dijkstra searches from a target polygon
+    uint64 Lookups;                         // paths taken from a field
+    uint64 Misses;                          // followers outside the field
+};
+
+/*
+ * Distances from one target over the navmesh polygons around it, shared by all units moving to it.
+ * The field is a single Dijkstra search from the polygon of the target: each polygon reached knows the
+ * neighbour it was reached from, which is the next polygon on the shortest way back to the target.
+ * A follower only finds its own polygon and walks these links, instead of an A* search per follower.
+ * The field is rebuilt when the target leaves the polygon it was built from.
+ */
+class FlowField
+{
+    public:
+        FlowField(ObjectGuid targetGuid, uint16 includeFlags);
+
+        // rebuilds the field if the target moved to another polygon, at most once per FLOW_FIELD_REBUILD_DELAY
+        void Update(Unit const* target);
+
+        // straight path from start towards dest through the field, false if start is outside the field
+        bool BuildPath(G3D::Vector3 const& start, G3D::Vector3 const& dest, Movement::PointsArray& path) const;
+
+        ObjectGuid GetTargetGUID() const { return _targetGuid; }
+        bool IsBuilt() const { return _targetPoly != 0; }
+        uint32 GetSize() const { return uint32(_nextPoly.size()); }
+
+        static FlowFieldStats GetStats();
+
+    private:
+        void Build(Unit const* target, float const* point);
+        dtPolyRef FindPoly(float const* point) const;
+
+        ObjectGuid _targetGuid;
+        dtNavMeshQuery const* _navMeshQuery;
+        dtQueryFilter _filter;
+
+        dtPolyRef _targetPoly;
+        uint32 _buildTime;
+        std::unordered_map<dtPolyRef, dtPolyRef> _nextPoly;    // polygon -> neighbour closer to the target
+
+        static std::atomic<uint64> _builds;
+        static std::atomic<uint64> _lookups;
+        static std::atomic<uint64> _misses;
+};
+
+#endif
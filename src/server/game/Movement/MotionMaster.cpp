@@ -26,10 +26,12 @@
 #include "IdleMovementGenerator.h"
 #include "PointMovementGenerator.h"
 #include "TargetedMovementGenerator.h"
+#include "FlowFieldMovementGenerator.h"
 #include "WaypointMovementGenerator.h"
 #include "RandomMovementGenerator.h"
 #include "MoveSpline.h"
 #include "MoveSplineInit.h"
+#include "World.h"
 
 inline bool isStatic(MovementGenerator *mv)
 {
@@ -253,6 +255,8 @@ void MotionMaster::MoveChase(Unit* target, float dist, float angle)
             target->GetTypeId() == TYPEID_PLAYER ? target->GetGUIDLow() : target->ToCreature()->GetDBTableGUIDLow());
         Mutate(new ChaseMovementGenerator<Player>(target, dist, angle), MOTION_SLOT_ACTIVE);
     }
+    else if (!dist && !angle && !_owner->IsPet() && sWorld->getBoolConfig(CONFIG_FLOW_FIELD_CHASE))
+        MoveFlowFieldChase(target);
     else
     {
         TC_LOG_DEBUG("misc", "Creature (Entry: %u GUID: %u) chase to %s (GUID: %u)",
@@ -263,6 +267,26 @@ void MotionMaster::MoveChase(Unit* target, float dist, float angle)
     }
 }
 
+void MotionMaster::MoveFlowFieldChase(Unit* target)
+{
+    // ignore movement request if target not exist
+    if (!target || target == _owner || _owner->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_DISABLE_MOVE))
+        return;
+
+    // only creatures chase in crowds
+    if (_owner->GetTypeId() != TYPEID_UNIT)
+    {
+        MoveChase(target);
+        return;
+    }
+
+    TC_LOG_DEBUG("misc", "Creature (Entry: %u GUID: %u) flow field chase to %s (GUID: %u)",
+        _owner->GetEntry(), _owner->GetGUIDLow(),
+        target->GetTypeId() == TYPEID_PLAYER ? "player" : "creature",
+        target->GetTypeId() == TYPEID_PLAYER ? target->GetGUIDLow() : target->ToCreature()->GetDBTableGUIDLow());
+    Mutate(new FlowFieldMovementGenerator<Creature>(target), MOTION_SLOT_ACTIVE);
+}
+
 void MotionMaster::MoveFollow(Unit* target, float dist, float angle, MovementSlot slot)
 {
     // ignore movement request if target not exist
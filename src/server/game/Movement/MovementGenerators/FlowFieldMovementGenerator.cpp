@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FlowFieldMovementGenerator.h"
+#include "Creature.h"
+#include "CreatureAI.h"
+#include "DisableMgr.h"
+#include "FlowField.h"
+#include "Map.h"
+#include "MoveSpline.h"
+#include "MoveSplineInit.h"
+#include "World.h"
+
+FlowFieldMovementGenerator<Creature>::~FlowFieldMovementGenerator()
+{
+    delete i_path;
+}
+
+void FlowFieldMovementGenerator<Creature>::DoInitialize(Creature* owner)
+{
+    owner->SetWalk(false);
+    owner->AddUnitState(UNIT_STATE_CHASE | UNIT_STATE_CHASE_MOVE);
+
+    // flying creatures do not follow the navmesh
+    if (!i_field && i_target.isValid() && !owner->CanFly() && DisableMgr::IsPathfindingEnabled(owner->GetMapId()))
+    {
+        // same filter as PathGenerator::CreateFilter
+        uint16 includeFlags = 0;
+        if (owner->CanWalk())
+            includeFlags |= NAV_GROUND;
+        if (owner->CanSwim())
+            includeFlags |= (NAV_WATER | NAV_MAGMA | NAV_SLIME);
+
+        i_field = owner->GetMap()->GetFlowField(i_target.getTarget(), includeFlags);
+    }
+
+    _setTargetLocation(owner);
+}
+
+void FlowFieldMovementGenerator<Creature>::DoFinalize(Creature* owner)
+{
+    owner->ClearUnitState(UNIT_STATE_CHASE | UNIT_STATE_CHASE_MOVE);
+}
+
+void FlowFieldMovementGenerator<Creature>::DoReset(Creature* owner)
+{
+    DoInitialize(owner);
+}
+
+void FlowFieldMovementGenerator<Creature>::_setTargetLocation(Creature* owner)
+{
+    if (!i_target.isValid() || !i_target->IsInWorld())
+        return;
+
+    if (owner->HasUnitState(UNIT_STATE_NOT_MOVE))
+        return;
+
+    if (!i_target->isInAccessiblePlaceFor(owner))
+        return;
+
+    // to nearest contact position, followers spread around the target by the side they come from
+    float x, y, z;
+    i_target->GetContactPoint(owner, x, y, z);
+    G3D::Vector3 dest(x, y, z);
+
+    Movement::PointsArray path;
+    i_partialPath = false;
+    if (i_field)
+    {
+        i_field->Update(i_target.getTarget());
+        if (i_field->BuildPath(G3D::Vector3(owner->GetPositionX(), owner->GetPositionY(), owner->GetPositionZ()), dest, path))
+        {
+            for (uint32 i = 0; i < path.size(); ++i)
+                owner->UpdateAllowedPositionZ(path[i].x, path[i].y, path[i].z);
+
+            i_partialPath = (path.back() - dest).squaredLength() > owner->GetCombatReach() * owner->GetCombatReach();
+        }
+    }
+
+    if (path.empty())
+    {
+        if (!i_path)
+            i_path = new PathGenerator(owner);
+
+        if (!i_path->CalculatePath(x, y, z) || (i_path->GetPathType() & PATHFIND_NOPATH))
+        {
+            // Cant reach target
+            i_recalculateTravel = true;
+            return;
+        }
+
+        path = i_path->GetPath();
+    }
+
+    owner->AddUnitState(UNIT_STATE_CHASE_MOVE);
+    i_targetReached = false;
+    i_recalculateTravel = false;
+
+    Movement::MoveSplineInit init(owner);
+    init.MovebyPath(path);
+    init.SetWalk(false);
+    init.SetFacing(i_target.getTarget());
+    init.Launch();
+}
+
+bool FlowFieldMovementGenerator<Creature>::DoUpdate(Creature* owner, uint32 time_diff)
+{
+    if (!i_target.isValid() || !i_target->IsInWorld())
+        return false;
+
+    if (!owner || !owner->IsAlive())
+        return false;
+
+    if (owner->HasUnitState(UNIT_STATE_NOT_MOVE))
+    {
+        owner->ClearUnitState(UNIT_STATE_CHASE_MOVE);
+        return true;
+    }
+
+    // prevent movement while casting spells with cast time or channel time
+    if (owner->HasUnitState(UNIT_STATE_CASTING))
+    {
+        if (!owner->IsStopped())
+            owner->StopMoving();
+        return true;
+    }
+
+    if (owner->GetVictim() != i_target.getTarget())
+    {
+        owner->ClearUnitState(UNIT_STATE_CHASE_MOVE);
+        return true;
+    }
+
+    bool targetMoved = false;
+    i_recheckDistance.Update(time_diff);
+    if (i_recheckDistance.Passed())
+    {
+        i_recheckDistance.Reset(100);
+
+        // a partial path is continued once its end is reached, not every time the target moves
+        if (!i_partialPath)
+        {
+            float allowedDist = owner->GetCombatReach() + sWorld->getRate(RATE_TARGET_POS_RECALCULATION_RANGE);
+            G3D::Vector3 dest = owner->movespline->FinalDestination();
+            targetMoved = !i_target->IsWithinDist2d(dest.x, dest.y, allowedDist);
+
+            if (!targetMoved)
+                targetMoved = !i_target->IsWithinLOSInMap(owner);
+        }
+    }
+
+    if (i_recalculateTravel || targetMoved || (i_partialPath && owner->movespline->Finalized()))
+        _setTargetLocation(owner);
+
+    if (owner->movespline->Finalized())
+    {
+        if (owner->AI())
+            owner->AI()->MovementInform(CHASE_MOTION_TYPE, i_target.getTarget()->GetGUIDLow());
+
+        if (!owner->HasInArc(0.01f, i_target.getTarget()))
+            owner->SetInFront(i_target.getTarget());
+
+        if (!i_targetReached)
+        {
+            i_targetReached = true;
+            if (owner->IsWithinMeleeRange(i_target.getTarget()))
+                owner->Attack(i_target.getTarget(), true);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_FLOWFIELDMOVEMENTGENERATOR_H
+#define TRINITY_FLOWFIELDMOVEMENTGENERATOR_H
+
+#include "TargetedMovementGenerator.h"
+#include <memory>
+
+class Creature;
+class FlowField;
+
+template<class T>
+class FlowFieldMovementGenerator;
+
+// Chase of a crowd: all creatures chasing the same target this way share the FlowField of the map
+// around it, only those outside of the field calculate a path of their own
+template<>
+class FlowFieldMovementGenerator<Creature> : public MovementGeneratorMedium< Creature, FlowFieldMovementGenerator<Creature> >, public TargetedMovementGeneratorBase
+{
+    public:
+        FlowFieldMovementGenerator(Unit* target) : TargetedMovementGeneratorBase(target), i_path(NULL),
+            i_recheckDistance(0), i_recalculateTravel(false), i_targetReached(false), i_partialPath(false) { }
+        ~FlowFieldMovementGenerator();
+
+        void DoInitialize(Creature*);
+        void DoFinalize(Creature*);
+        void DoReset(Creature*);
+        bool DoUpdate(Creature*, uint32);
+        // a chase like ChaseMovementGenerator for scripts and AI
+        MovementGeneratorType GetMovementGeneratorType() override { return CHASE_MOTION_TYPE; }
+
+        Unit* GetTarget() const { return i_target.getTarget(); }
+        void unitSpeedChanged() override { i_recalculateTravel = true; }
+
+    private:
+        void _setTargetLocation(Creature*);
+
+        std::shared_ptr<FlowField> i_field;
+        PathGenerator* i_path;              // outside of the field
+        TimeTrackerSmall i_recheckDistance;
+        bool i_recalculateTravel : 1;
+        bool i_targetReached : 1;
+        bool i_partialPath : 1;             // ends where the field corridor ends, before the target
+};
+
+#endif
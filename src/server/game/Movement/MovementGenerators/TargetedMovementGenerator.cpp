@@ -26,6 +26,7 @@
 #include "MoveSpline.h"
 #include "Player.h"
 #include "VehicleDefines.h"
+#include "PathfindingMgr.h"
 
 template<class T, typename D>
 void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T* owner, bool updateDestination)
@@ -93,8 +94,25 @@ void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T* owner, bool up
     bool forceDest = (owner->GetTypeId() == TYPEID_UNIT && owner->ToCreature()->IsPet()
         && owner->HasUnitState(UNIT_STATE_FOLLOW));
 
-    bool result = i_path->CalculatePath(x, y, z, forceDest);
-    if (!result || (i_path->GetPathType() & PATHFIND_NOPATH))
+    bool result = i_path->CalculatePathAsync(i_pathRequest, x, y, z, forceDest);
+    if (!result)
+    {
+        // Cant reach target
+        i_recalculateTravel = true;
+        return;
+    }
+
+    // the path is launched by DoUpdate once the pathfinding thread is done with it
+    if (i_pathRequest)
+        return;
+
+    _moveByPath(owner);
+}
+
+template<class T, typename D>
+void TargetedMovementGeneratorMedium<T, D>::_moveByPath(T* owner)
+{
+    if (i_path->GetPathType() & PATHFIND_NOPATH)
     {
         // Cant reach target
         i_recalculateTravel = true;
@@ -170,7 +188,17 @@ bool TargetedMovementGeneratorMedium<T, D>::DoUpdate(T* owner, uint32 time_diff)
             targetMoved = !i_target->IsWithinLOSInMap(owner);
     }
 
-    if (i_recalculateTravel || targetMoved)
+    if (i_pathRequest)
+    {
+        // wait for the pending path instead of asking for a new one every time the target moves
+        if (i_pathRequest->IsReady())
+        {
+            i_path->FinishPath(*i_pathRequest);
+            i_pathRequest.reset();
+            _moveByPath(owner);
+        }
+    }
+    else if (i_recalculateTravel || targetMoved)
         _setTargetLocation(owner, targetMoved);
 
     if (owner->movespline->Finalized())
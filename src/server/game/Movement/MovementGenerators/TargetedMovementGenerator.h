@@ -54,8 +54,10 @@ class TargetedMovementGeneratorMedium : public MovementGeneratorMedium< T, D >,
         bool IsReachable() const { return (i_path) ? (i_path->GetPathType() & PATHFIND_NORMAL) : true; }
     protected:
         void _setTargetLocation(T* owner, bool updateDestination);
+        void _moveByPath(T* owner);
 
         PathGenerator* i_path;
+        PathRequestPtr i_pathRequest;   // navmesh query still running on a pathfinding thread
         TimeTrackerSmall i_recheckDistance;
         float i_offset;
         float i_angle;
@@ -25,24 +25,27 @@
 #include "DisableMgr.h"
 #include "DetourCommon.h"
 #include "DetourNavMeshQuery.h"
+#include "PathfindingMgr.h"
 
 ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(const Unit* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
     _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _straightLine(false),
-    _endPosition(G3D::Vector3::zero()), _sourceUnit(owner), _navMesh(NULL),
-    _navMeshQuery(NULL)
+    _endPosition(G3D::Vector3::zero()), _sourceUnit(owner), _sourceGuidLow(owner->GetGUIDLow()),
+    _mapId(owner->GetMapId()), _navMesh(NULL), _navMeshQuery(NULL), _pathCache(NULL), _canFly(false), _canSwim(false),
+    _startUnderWater(false), _endUnderWater(false), _queryPending(false), _normalizePending(false),
+    _finishStep(PATH_FINISH_NONE)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
-    TC_LOG_DEBUG("maps", "++ PathGenerator::PathGenerator for %u \n", _sourceUnit->GetGUIDLow());
+    TC_LOG_DEBUG("maps", "++ PathGenerator::PathGenerator for %u \n", _sourceGuidLow);
 
-    uint32 mapId = _sourceUnit->GetMapId();
-    if (DisableMgr::IsPathfindingEnabled(mapId))
+    if (DisableMgr::IsPathfindingEnabled(_mapId))
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
-        _navMesh = mmap->GetNavMesh(mapId);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _sourceUnit->GetInstanceId());
+        _navMesh = mmap->GetNavMesh(_mapId);
+        _navMeshQuery = mmap->GetNavMeshQuery(_mapId, _sourceUnit->GetInstanceId());
+        _pathCache = mmap->GetPathCache(_mapId);
     }
 
     CreateFilter();
@@ -50,10 +53,64 @@ PathGenerator::PathGenerator(const Unit* owner) :
 
 PathGenerator::~PathGenerator()
 {
-    TC_LOG_DEBUG("maps", "++ PathGenerator::~PathGenerator() for %u \n", _sourceUnit->GetGUIDLow());
+    // may be a copy owned by a path request that outlives the unit, do not touch _sourceUnit here
+    TC_LOG_DEBUG("maps", "++ PathGenerator::~PathGenerator() for %u \n", _sourceGuidLow);
 }
 
 bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool forceDest, bool straightLine)
+{
+    if (!PrepareCalculation(destX, destY, destZ, forceDest, straightLine))
+        return false;
+
+    if (_queryPending)
+        QueryPath(_navMeshQuery, _pathCache);
+
+    FinishCalculation();
+    return true;
+}
+
+bool PathGenerator::CalculatePathAsync(PathRequestPtr& request, float destX, float destY, float destZ, bool forceDest)
+{
+    request.reset();
+
+    if (!PrepareCalculation(destX, destY, destZ, forceDest, false))
+        return false;
+
+    if (_queryPending)
+    {
+        if (sPathfindingMgr->IsActive())
+        {
+            request = sPathfindingMgr->Request(*this);
+            return true;
+        }
+
+        QueryPath(_navMeshQuery, _pathCache);
+    }
+
+    FinishCalculation();
+    return true;
+}
+
+void PathGenerator::FinishPath(PathRequest const& request)
+{
+    PathGenerator const& result = request.GetPath();
+
+    memcpy(_pathPolyRefs, result._pathPolyRefs, sizeof(_pathPolyRefs));
+    _polyLength = result._polyLength;
+    _pathPoints = result._pathPoints;
+    _type = result._type;
+    _startPosition = result._startPosition;
+    _endPosition = result._endPosition;
+    _actualEndPosition = result._actualEndPosition;
+    _normalizePending = result._normalizePending;
+    _finishStep = result._finishStep;
+    _queryPending = false;
+
+    // heights and forced destination for this unit, the request may be shared with others
+    FinishCalculation();
+}
+
+bool PathGenerator::PrepareCalculation(float destX, float destY, float destZ, bool forceDest, bool straightLine)
 {
     float x, y, z;
     _sourceUnit->GetPosition(x, y, z);
@@ -69,8 +126,10 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
 
     _forceDestination = forceDest;
     _straightLine = straightLine;
+    _queryPending = false;
+    _finishStep = PATH_FINISH_NONE;
 
-    TC_LOG_DEBUG("maps", "++ PathGenerator::CalculatePath() for %u \n", _sourceUnit->GetGUIDLow());
+    TC_LOG_DEBUG("maps", "++ PathGenerator::CalculatePath() for %u \n", _sourceGuidLow);
 
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
@@ -84,10 +143,96 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
 
     UpdateFilter();
 
-    BuildPolyPath(start, dest);
+    _canFly = _sourceUnit->GetTypeId() == TYPEID_UNIT && _sourceUnit->ToCreature()->CanFly();
+    _canSwim = _sourceUnit->GetTypeId() == TYPEID_UNIT && _sourceUnit->ToCreature()->CanSwim();
+
+    // only needed to choose between flying and swimming when far from the navmesh
+    _startUnderWater = false;
+    _endUnderWater = false;
+    if (_canFly != _canSwim)
+    {
+        Map const* map = _sourceUnit->GetBaseMap();
+        _startUnderWater = map->IsUnderWater(start.x, start.y, start.z);
+        _endUnderWater = map->IsUnderWater(dest.x, dest.y, dest.z);
+    }
+
+    _queryPending = true;
     return true;
 }
 
+void PathGenerator::QueryPath(dtNavMeshQuery const* query, MMAP::PathCache* pathCache)
+{
+    _queryPending = false;
+    _navMeshQuery = query;
+    _pathCache = pathCache;
+
+    if (!_navMeshQuery)
+    {
+        // the navmesh was unloaded before a pathfinding thread got to the request
+        BuildShortcut();
+        _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        return;
+    }
+
+    BuildPolyPath(_startPosition, _endPosition);
+}
+
+void PathGenerator::FinishCalculation()
+{
+    if (_normalizePending)
+        NormalizePath();
+
+    switch (_finishStep)
+    {
+        case PATH_FINISH_WATER_CHECK:
+        {
+            // Check both start and end points, if they're both in water, then we can *safely* let the creature move
+            bool waterPath = true;
+            for (uint32 i = 0; i < _pathPoints.size(); ++i)
+            {
+                ZLiquidStatus status = _sourceUnit->GetBaseMap()->getLiquidStatus(_pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z, MAP_ALL_LIQUIDS, NULL);
+                // One of the points is not in the water, cancel movement.
+                if (status == LIQUID_MAP_NO_WATER)
+                {
+                    waterPath = false;
+                    break;
+                }
+            }
+
+            _type = waterPath ? PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH) : PATHFIND_NOPATH;
+            break;
+        }
+        case PATH_FINISH_POINT_PATH:
+            // first point is always our current location - we need the next one
+            SetActualEndPosition(_pathPoints[_pathPoints.size() - 1]);
+
+            // force the given destination, if needed
+            if (_forceDestination &&
+                (!(_type & PATHFIND_NORMAL) || !InRange(GetEndPosition(), GetActualEndPosition(), 1.0f, 1.0f)))
+            {
+                // we may want to keep partial subpath
+                if (Dist3DSqr(GetActualEndPosition(), GetEndPosition()) < 0.3f * Dist3DSqr(GetStartPosition(), GetEndPosition()))
+                {
+                    SetActualEndPosition(GetEndPosition());
+                    _pathPoints[_pathPoints.size()-1] = GetEndPosition();
+                }
+                else
+                {
+                    SetActualEndPosition(GetEndPosition());
+                    BuildShortcut();
+                    NormalizePath();
+                }
+
+                _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+            }
+            break;
+        default:
+            break;
+    }
+
+    _finishStep = PATH_FINISH_NONE;
+}
+
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -173,25 +318,16 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     {
         TC_LOG_DEBUG("maps", "++ BuildPolyPath :: (startPoly == 0 || endPoly == 0)\n");
         BuildShortcut();
-        bool path = _sourceUnit->GetTypeId() == TYPEID_UNIT && _sourceUnit->ToCreature()->CanFly();
-
-        bool waterPath = _sourceUnit->GetTypeId() == TYPEID_UNIT && _sourceUnit->ToCreature()->CanSwim();
-        if (waterPath)
+        if (_canFly)
+            _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        else
         {
-            // Check both start and end points, if they're both in water, then we can *safely* let the creature move
-            for (uint32 i = 0; i < _pathPoints.size(); ++i)
-            {
-                ZLiquidStatus status = _sourceUnit->GetBaseMap()->getLiquidStatus(_pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z, MAP_ALL_LIQUIDS, NULL);
-                // One of the points is not in the water, cancel movement.
-                if (status == LIQUID_MAP_NO_WATER)
-                {
-                    waterPath = false;
-                    break;
-                }
-            }
-        }
+            _type = PATHFIND_NOPATH;
 
-        _type = (path || waterPath) ? PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH) : PATHFIND_NOPATH;
+            // swimmers may use it if the points are in water, decided once the heights are adjusted
+            if (_canSwim)
+                _finishStep = PATH_FINISH_WATER_CHECK;
+        }
         return;
     }
 
@@ -202,21 +338,19 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         TC_LOG_DEBUG("maps", "++ BuildPolyPath :: farFromPoly distToStartPoly=%.3f distToEndPoly=%.3f\n", distToStartPoly, distToEndPoly);
 
         bool buildShotrcut = false;
-        if (_sourceUnit->GetTypeId() == TYPEID_UNIT)
+        if (_canFly || _canSwim)
         {
-            Creature* owner = (Creature*)_sourceUnit;
-
-            G3D::Vector3 const& p = (distToStartPoly > 7.0f) ? startPos : endPos;
-            if (_sourceUnit->GetBaseMap()->IsUnderWater(p.x, p.y, p.z))
+            bool underWater = (distToStartPoly > 7.0f) ? _startUnderWater : _endUnderWater;
+            if (underWater)
             {
                 TC_LOG_DEBUG("maps", "++ BuildPolyPath :: underWater case\n");
-                if (owner->CanSwim())
+                if (_canSwim)
                     buildShotrcut = true;
             }
             else
             {
                 TC_LOG_DEBUG("maps", "++ BuildPolyPath :: flying case\n");
-                if (owner->CanFly())
+                if (_canFly)
                     buildShotrcut = true;
             }
         }
@@ -276,7 +410,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                 TC_LOG_ERROR("maps", "Invalid poly ref in BuildPolyPath. _polyLength: %u, pathStartIndex: %u,"
                                      " startPos: %s, endPos: %s, mapid: %u",
                                      _polyLength, pathStartIndex, startPos.toString().c_str(), endPos.toString().c_str(),
-                                     _sourceUnit->GetMapId());
+                                     _mapId);
 
                 break;
             }
@@ -376,14 +510,13 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
+            dtResult = FindPolyPath(
                             suffixStartPoly,    // start polygon
                             endPoly,            // end polygon
                             suffixEndPoint,     // start position
                             endPoint,           // end position
-                            &_filter,            // polygon search filter
                             _pathPolyRefs + prefixPolyLength - 1,    // [out] path
-                            (int*)&suffixPolyLength,
+                            suffixPolyLength,
                             MAX_PATH_LENGTH - prefixPolyLength);   // max number of polygons in output path
         }
 
@@ -392,7 +525,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
             // this is probably an error state, but we'll leave it
             // and hopefully recover on the next Update
             // we still need to copy our preffix
-            TC_LOG_ERROR("maps", "%u's Path Build failed: 0 length path", _sourceUnit->GetGUIDLow());
+            TC_LOG_ERROR("maps", "%u's Path Build failed: 0 length path", _sourceGuidLow);
         }
 
         TC_LOG_DEBUG("maps", "++  m_polyLength=%u prefixPolyLength=%u suffixPolyLength=%u \n", _polyLength, prefixPolyLength, suffixPolyLength);
@@ -439,21 +572,20 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
+            dtResult = FindPolyPath(
                             startPoly,          // start polygon
                             endPoly,            // end polygon
                             startPoint,         // start position
                             endPoint,           // end position
-                            &_filter,           // polygon search filter
-                            _pathPolyRefs,     // [out] path
-                            (int*)&_polyLength,
+                            _pathPolyRefs,      // [out] path
+                            _polyLength,
                             MAX_PATH_LENGTH);   // max number of polygons in output path
         }
 
         if (!_polyLength || dtStatusFailed(dtResult))
         {
             // only happens if we passed bad data to findPath(), or navmesh is messed up
-            TC_LOG_ERROR("maps", "%u's Path Build failed: 0 length path", _sourceUnit->GetGUIDLow());
+            TC_LOG_ERROR("maps", "%u's Path Build failed: 0 length path", _sourceGuidLow);
             BuildShortcut();
             _type = PATHFIND_NOPATH;
             return;
@@ -470,6 +602,25 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     BuildPointPath(startPoint, endPoint);
 }
 
+dtStatus PathGenerator::FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint,
+                                     dtPolyRef* path, uint32& pathSize, uint32 maxPathSize)
+{
+    uint32 filter = _filter.getIncludeFlags() | (uint32(_filter.getExcludeFlags()) << 16);
+
+    // another unit already went to the same end polygon through our start polygon
+    if (_pathCache && _pathCache->Find(startPoly, endPoly, filter, path, pathSize, maxPathSize))
+        return DT_SUCCESS;
+
+    dtStatus dtResult = _navMeshQuery->findPath(startPoly, endPoly, startPoint, endPoint, &_filter,
+        path, (int*)&pathSize, maxPathSize);
+
+    // partial paths do not end at endPoly and are of no use to anyone else
+    if (_pathCache && dtStatusSucceed(dtResult) && pathSize && path[pathSize - 1] == endPoly)
+        _pathCache->Insert(path, pathSize, filter);
+
+    return dtResult;
+}
+
 void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoint)
 {
     float pathPoints[MAX_POINT_PATH_LENGTH*VERTEX_SIZE];
@@ -548,29 +699,9 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
     for (uint32 i = 0; i < pointCount; ++i)
         _pathPoints[i] = G3D::Vector3(pathPoints[i*VERTEX_SIZE+2], pathPoints[i*VERTEX_SIZE], pathPoints[i*VERTEX_SIZE+1]);
 
-    NormalizePath();
-
-    // first point is always our current location - we need the next one
-    SetActualEndPosition(_pathPoints[pointCount-1]);
-
-    // force the given destination, if needed
-    if (_forceDestination &&
-        (!(_type & PATHFIND_NORMAL) || !InRange(GetEndPosition(), GetActualEndPosition(), 1.0f, 1.0f)))
-    {
-        // we may want to keep partial subpath
-        if (Dist3DSqr(GetActualEndPosition(), GetEndPosition()) < 0.3f * Dist3DSqr(GetStartPosition(), GetEndPosition()))
-        {
-            SetActualEndPosition(GetEndPosition());
-            _pathPoints[_pathPoints.size()-1] = GetEndPosition();
-        }
-        else
-        {
-            SetActualEndPosition(GetEndPosition());
-            BuildShortcut();
-        }
-
-        _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
-    }
+    // heights, end position and forced destination are applied on the map thread
+    _normalizePending = true;
+    _finishStep = PATH_FINISH_POINT_PATH;
 
     TC_LOG_DEBUG("maps", "++ PathGenerator::BuildPointPath path type %d size %d poly-size %d\n", _type, pointCount, _polyLength);
 }
@@ -579,6 +710,8 @@ void PathGenerator::NormalizePath()
 {
     for (uint32 i = 0; i < _pathPoints.size(); ++i)
         _sourceUnit->UpdateAllowedPositionZ(_pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z);
+
+    _normalizePending = false;
 }
 
 void PathGenerator::BuildShortcut()
@@ -594,7 +727,7 @@ void PathGenerator::BuildShortcut()
     _pathPoints[0] = GetStartPosition();
     _pathPoints[1] = GetActualEndPosition();
 
-    NormalizePath();
+    _normalizePending = true;
 
     _type = PATHFIND_SHORTCUT;
 }
@@ -854,7 +987,7 @@ dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPo
 
             // Handle the connection.
             float startPos[VERTEX_SIZE], endPos[VERTEX_SIZE];
-            if (dtStatusSucceed(_navMesh->getOffMeshConnectionPolyEndPoints(prevRef, polyRef, startPos, endPos)))
+            if (dtStatusSucceed(_navMeshQuery->getAttachedNavMesh()->getOffMeshConnectionPolyEndPoints(prevRef, polyRef, startPos, endPos)))
             {
                 if (nsmoothPath < maxSmoothPathSize)
                 {
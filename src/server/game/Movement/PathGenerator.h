@@ -23,8 +23,17 @@
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
 #include "MoveSplineInitArgs.h"
+#include <memory>
+
+namespace MMAP
+{
+    class PathCache;
+}
 
 class Unit;
+class PathRequest;
+
+typedef std::shared_ptr<PathRequest> PathRequestPtr;
 
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -49,8 +58,18 @@ enum PathType
     PATHFIND_SHORT          = 0x20,   // path is longer or equal to its limited path length
 };
 
+// what is left to do on the map thread after the navmesh was queried
+enum PathFinishStep
+{
+    PATH_FINISH_NONE,           // at most the heights of new points
+    PATH_FINISH_WATER_CHECK,    // shortcut through a hole in the navmesh, only swimmers may use it and only in water
+    PATH_FINISH_POINT_PATH      // point path built, end position and forced destination not applied yet
+};
+
 class PathGenerator
 {
+        friend class PathfindingMgr;
+
     public:
         explicit PathGenerator(Unit const* owner);
         ~PathGenerator();
@@ -59,6 +78,11 @@ class PathGenerator
         // return: true if new path was calculated, false otherwise (no change needed)
         bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false, bool straightLine = false);
 
+        // Same as CalculatePath, but the navmesh part runs on a pathfinding thread if those are enabled.
+        // Then request is set and the path stays unchanged until FinishPath is called with the request once it is ready.
+        bool CalculatePathAsync(PathRequestPtr& request, float destX, float destY, float destZ, bool forceDest = false);
+        void FinishPath(PathRequest const& request);
+
         // option setters - use optional
         void SetUseStraightPath(bool useStraightPath) { _useStraightPath = useStraightPath; }
         void SetPathLengthLimit(float distance) { _pointPathLimit = std::min<uint32>(uint32(distance/SMOOTH_PATH_STEP_SIZE), MAX_POINT_PATH_LENGTH); }
@@ -92,16 +116,34 @@ class PathGenerator
         G3D::Vector3 _actualEndPosition;    // {x, y, z} of the closest possible point to given destination
 
         Unit const* const _sourceUnit;          // the unit that is moving
+        uint32 _sourceGuidLow;
+        uint32 _mapId;
         dtNavMesh const* _navMesh;              // the nav mesh
         dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path
+        MMAP::PathCache* _pathCache;            // poly paths found for other units on the same navmesh
 
         dtQueryFilter _filter;  // use single filter for all movements, update it when needed
 
+        // state of the unit and terrain taken before the navmesh is queried, that part may run on another thread
+        bool _canFly;
+        bool _canSwim;
+        bool _startUnderWater;
+        bool _endUnderWater;
+
+        bool _queryPending;             // prepared, navmesh not queried yet
+        bool _normalizePending;         // new points without adjusted heights
+        PathFinishStep _finishStep;
+
         void SetStartPosition(G3D::Vector3 const& point) { _startPosition = point; }
         void SetEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; _endPosition = point; }
         void SetActualEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; }
         void NormalizePath();
 
+        // CalculatePath steps: the first and last run on the map thread, QueryPath does not touch the unit or the map
+        bool PrepareCalculation(float destX, float destY, float destZ, bool forceDest, bool straightLine);
+        void QueryPath(dtNavMeshQuery const* query, MMAP::PathCache* pathCache);
+        void FinishCalculation();
+
         void Clear()
         {
             _polyLength = 0;
@@ -117,6 +159,8 @@ class PathGenerator
         bool HaveTile(G3D::Vector3 const& p) const;
 
         void BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
+        dtStatus FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint,
+                              dtPolyRef* path, uint32& pathSize, uint32 maxPathSize);
         void BuildPointPath(float const* startPoint, float const* endPoint);
         void BuildShortcut();
 
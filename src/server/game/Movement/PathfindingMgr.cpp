@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathfindingMgr.h"
+#include "MMapFactory.h"
+#include "MMapManager.h"
+#include "Log.h"
+#include <cmath>
+
+enum PathRequestOptions
+{
+    PATH_REQUEST_STRAIGHT_PATH      = 0x01,
+    PATH_REQUEST_STRAIGHT_LINE      = 0x02,
+    PATH_REQUEST_CAN_FLY            = 0x04,
+    PATH_REQUEST_CAN_SWIM           = 0x08,
+    PATH_REQUEST_START_UNDER_WATER  = 0x10,
+    PATH_REQUEST_END_UNDER_WATER    = 0x20
+};
+
+bool PathRequestKey::operator==(PathRequestKey const& right) const
+{
+    return MapId == right.MapId &&
+        Start[0] == right.Start[0] && Start[1] == right.Start[1] && Start[2] == right.Start[2] &&
+        End[0] == right.End[0] && End[1] == right.End[1] && End[2] == right.End[2] &&
+        IncludeFlags == right.IncludeFlags && ExcludeFlags == right.ExcludeFlags &&
+        PointPathLimit == right.PointPathLimit && Options == right.Options;
+}
+
+size_t PathRequestKeyHash::operator()(PathRequestKey const& key) const
+{
+    size_t hash = key.MapId;
+    for (uint8 i = 0; i < 3; ++i)
+    {
+        hash = hash * 31 + std::hash<int32>()(key.Start[i]);
+        hash = hash * 31 + std::hash<int32>()(key.End[i]);
+    }
+
+    return hash * 31 + (key.IncludeFlags | (key.ExcludeFlags << 16)) + (key.Options << 8) + key.PointPathLimit;
+}
+
+void PathfindingMgr::Activate(uint32 threads)
+{
+    MMAP::MMapFactory::createOrGetMMapManager()->setWorkerCount(threads);
+
+    for (uint32 i = 0; i < threads; ++i)
+        _workerThreads.push_back(std::thread(&PathfindingMgr::WorkerThread, this, i));
+
+    if (threads)
+        TC_LOG_INFO("maps", "Started %u pathfinding threads", threads);
+}
+
+void PathfindingMgr::Deactivate()
+{
+    _cancelationToken = true;
+
+    _queue.Cancel();
+
+    for (auto& thread : _workerThreads)
+        thread.join();
+
+    _workerThreads.clear();
+}
+
+PathRequestPtr PathfindingMgr::Request(PathGenerator const& path)
+{
+    PathRequestKey key;
+    key.MapId = path._mapId;
+    for (uint8 i = 0; i < 3; ++i)
+    {
+        key.Start[i] = int32(std::floor(path._startPosition[i] / PATH_REQUEST_PRECISION));
+        key.End[i] = int32(std::floor(path._endPosition[i] / PATH_REQUEST_PRECISION));
+    }
+    key.IncludeFlags = path._filter.getIncludeFlags();
+    key.ExcludeFlags = path._filter.getExcludeFlags();
+    key.PointPathLimit = path._pointPathLimit;
+    key.Options = 0;
+    if (path._useStraightPath)
+        key.Options |= PATH_REQUEST_STRAIGHT_PATH;
+    if (path._straightLine)
+        key.Options |= PATH_REQUEST_STRAIGHT_LINE;
+    if (path._canFly)
+        key.Options |= PATH_REQUEST_CAN_FLY;
+    if (path._canSwim)
+        key.Options |= PATH_REQUEST_CAN_SWIM;
+    if (path._startUnderWater)
+        key.Options |= PATH_REQUEST_START_UNDER_WATER;
+    if (path._endUnderWater)
+        key.Options |= PATH_REQUEST_END_UNDER_WATER;
+
+    ++_requestCount;
+
+    PathRequestPtr request;
+    {
+        std::lock_guard<std::mutex> lock(_pendingLock);
+
+        std::weak_ptr<PathRequest>& pending = _pendingRequests[key];
+        request = pending.lock();
+        if (request)
+        {
+            ++_sharedRequestCount;
+            return request;
+        }
+
+        request = std::make_shared<PathRequest>(path);
+        pending = request;
+    }
+
+    QueuedRequest* queued = new QueuedRequest();
+    queued->Key = key;
+    queued->Request = request;
+    _queue.Push(queued);
+
+    return request;
+}
+
+void PathfindingMgr::WorkerThread(uint32 workerId)
+{
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+
+    while (1)
+    {
+        QueuedRequest* queued = nullptr;
+
+        _queue.WaitAndPop(queued);
+
+        if (_cancelationToken)
+        {
+            delete queued;
+            return;
+        }
+
+        // nobody waits for it anymore, the owners moved on or are gone
+        if (PathRequestPtr request = queued->Request.lock())
+        {
+            {
+                boost::shared_lock<boost::shared_mutex> lock(mmap->GetMeshLock());
+                uint32 mapId = request->_path._mapId;
+                request->_path.QueryPath(mmap->GetWorkerNavMeshQuery(mapId, workerId), mmap->GetPathCache(mapId));
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_pendingLock);
+                auto itr = _pendingRequests.find(queued->Key);
+                if (itr != _pendingRequests.end() && itr->second.lock() == request)
+                    _pendingRequests.erase(itr);
+            }
+
+            request->_ready.store(true, std::memory_order_release);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(_pendingLock);
+            auto itr = _pendingRequests.find(queued->Key);
+            if (itr != _pendingRequests.end() && itr->second.expired())
+                _pendingRequests.erase(itr);
+        }
+
+        delete queued;
+    }
+}
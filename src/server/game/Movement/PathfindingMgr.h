@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PATHFINDING_MGR_H
+#define _PATHFINDING_MGR_H
+
+#include "Define.h"
+#include "PathGenerator.h"
+#include "ProducerConsumerQueue.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Everything the navmesh part of a path calculation depends on, positions rounded to PATH_REQUEST_PRECISION
+struct PathRequestKey
+{
+    uint32 MapId;
+    int32 Start[3];
+    int32 End[3];
+    uint16 IncludeFlags;
+    uint16 ExcludeFlags;
+    uint32 PointPathLimit;
+    uint8 Options;
+
+    bool operator==(PathRequestKey const& right) const;
+};
+
+struct PathRequestKeyHash
+{
+    size_t operator()(PathRequestKey const& key) const;
+};
+
+#define PATH_REQUEST_PRECISION 0.25f
+
+// The copy of a prepared PathGenerator a pathfinding thread queries the navmesh for
+class PathRequest
+{
+    friend class PathfindingMgr;
+
+    public:
+        explicit PathRequest(PathGenerator const& path) : _path(path), _ready(false) { }
+
+        bool IsReady() const { return _ready.load(std::memory_order_acquire); }
+
+        // only valid once IsReady()
+        PathGenerator const& GetPath() const { return _path; }
+
+    private:
+        PathGenerator _path;
+        std::atomic<bool> _ready;
+};
+
+/*
+ * Runs the navmesh part of path calculations on its own threads, each with its own dtNavMeshQuery per map,
+ * while the map threads go on. Requests are dropped when nobody holds them anymore, identical pending
+ * requests (same map, options and rounded start and end) are calculated once and shared.
+ */
+class PathfindingMgr
+{
+    struct QueuedRequest
+    {
+        PathRequestKey Key;
+        std::weak_ptr<PathRequest> Request;
+    };
+
+    public:
+        static PathfindingMgr* instance()
+        {
+            static PathfindingMgr instance;
+            return &instance;
+        }
+
+        void Activate(uint32 threads);
+        void Deactivate();
+        bool IsActive() const { return !_workerThreads.empty(); }
+
+        // path must be prepared and waiting for its navmesh query
+        PathRequestPtr Request(PathGenerator const& path);
+
+        uint64 GetRequestCount() const { return _requestCount; }
+        uint64 GetSharedRequestCount() const { return _sharedRequestCount; }
+
+    private:
+        PathfindingMgr() : _cancelationToken(false), _requestCount(0), _sharedRequestCount(0) { }
+        ~PathfindingMgr() { }
+
+        void WorkerThread(uint32 workerId);
+
+        ProducerConsumerQueue<QueuedRequest*> _queue;
+        std::vector<std::thread> _workerThreads;
+        std::atomic<bool> _cancelationToken;
+
+        std::mutex _pendingLock;
+        std::unordered_map<PathRequestKey, std::weak_ptr<PathRequest>, PathRequestKeyHash> _pendingRequests;
+
+        std::atomic<uint64> _requestCount;
+        std::atomic<uint64> _sharedRequestCount;
+
+        PathfindingMgr(PathfindingMgr const&) = delete;
+        PathfindingMgr& operator=(PathfindingMgr const&) = delete;
+};
+
+#define sPathfindingMgr PathfindingMgr::instance()
+
+#endif
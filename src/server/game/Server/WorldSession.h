@@ -205,6 +205,19 @@ class CharacterCreateInfo
 
         /// Server side data
         uint8 CharCount = 0;
+        uint8 Stage     = 0;                                // step of the HandleCharCreateCallback chain
+};
+
+// Login data of the character most likely to be chosen, loaded speculatively while the character list is shown
+struct CharacterLoginPrefetch
+{
+    explicit CharacterLoginPrefetch(ObjectGuid guid) : Guid(guid), Time(0), Holder(NULL), LoginRequested(false) { }
+    ~CharacterLoginPrefetch();
+
+    ObjectGuid Guid;
+    uint32 Time;                                        // getMSTime() when the load was queued
+    LoginQueryHolder* Holder;                           // set once loaded, the load is still in flight until then
+    bool LoginRequested;                                // CMSG_PLAYER_LOGIN arrived during the load, its callback continues the login
 };
 
 struct CharacterRenameInfo
@@ -445,10 +458,11 @@ class WorldSession
         void HandleCharEnumOpcode(WorldPacket& recvPacket);
         void HandleCharDeleteOpcode(WorldPacket& recvPacket);
         void HandleCharCreateOpcode(WorldPacket& recvPacket);
-        void HandleCharCreateCallback(PreparedQueryResult result, CharacterCreateInfo* createInfo);
+        void HandleCharCreateCallback(PreparedQueryResult result, std::shared_ptr<CharacterCreateInfo> createInfo);
         void HandlePlayerLoginOpcode(WorldPacket& recvPacket);
         void HandleCharEnum(PreparedQueryResult result);
         void HandlePlayerLogin(LoginQueryHolder * holder);
+        void PrefetchPlayerLogin(ObjectGuid guid);
         void HandleCharFactionOrRaceChange(WorldPacket& recvData);
         void SendCharCreate(ResponseCodes result);
         void SendCharDelete(ResponseCodes result);
@@ -965,19 +979,16 @@ class WorldSession
 		void ModifyAccountSpell(bool learn, uint32 spell);
 		void UpdateAccountSpells();
     private:
-        void InitializeQueryCallbackParameters();
         void ProcessQueryCallbacks();
 
-        PreparedQueryResultFuture _charEnumCallback;
-        PreparedQueryResultFuture _addIgnoreCallback;
-        PreparedQueryResultFuture _stablePetCallback;
-        QueryCallback<PreparedQueryResult, CharacterRenameInfo*> _charRenameCallback;
-        QueryCallback<PreparedQueryResult, std::string> _addFriendCallback;
-        QueryCallback<PreparedQueryResult, uint32> _unstablePetCallback;
-        QueryCallback<PreparedQueryResult, uint32> _stableSwapCallback;
-        QueryCallback<PreparedQueryResult, ObjectGuid> _sendStabledPetCallback;
-        QueryCallback<PreparedQueryResult, CharacterCreateInfo*, true> _charCreateCallback;
-        QueryResultHolderFuture _charLoginCallback;
+        // Async query results of this session are pushed here by the database workers
+        SQLQueryCompletionQueuePtr _queryCompletionQueue;
+        // Character creation in progress, a new CMSG_CHAR_CREATE replaces it and abandons its callback chain
+        std::shared_ptr<CharacterCreateInfo> _charCreateInfo;
+        // Speculative login load started by HandleCharEnum, dropped when replaced or not used
+        std::shared_ptr<CharacterLoginPrefetch> _loginPrefetch;
+        // CMSG_CHAR_ENUM query queued and its result not handled yet
+        bool _charEnumPending;
 
     friend class World;
     protected:
@@ -408,6 +408,24 @@ void AuraEffect::GetTargetList(std::list<Unit*> & targetList) const
     }
 }
 
+void AuraEffect::SetAmount(int32 amount)
+{
+    if (m_amount != amount)
+    {
+        m_amount = amount;
+        InvalidateTargetsAuraModifierCache();
+    }
+    m_canBeRecalculated = false;
+}
+
+void AuraEffect::InvalidateTargetsAuraModifierCache()
+{
+    Aura::ApplicationMap const& targetMap = GetBase()->GetApplicationMap();
+    for (Aura::ApplicationMap::const_iterator appIter = targetMap.begin(); appIter != targetMap.end(); ++appIter)
+        if (appIter->second->HasEffect(GetEffIndex()))
+            appIter->second->GetTarget()->InvalidateAuraModifierCache(GetAuraType());
+}
+
 void AuraEffect::GetApplicationList(std::list<AuraApplication*> & applicationList) const
 {
     Aura::ApplicationMap const & targetMap = GetBase()->GetApplicationMap();
@@ -498,6 +516,8 @@ int32 AuraEffect::CalculateAmount(Unit* caster)
 
 void AuraEffect::CalculatePeriodic(Unit* caster, bool create, bool load)
 {
+    GetBase()->_SyncUpdateTime();
+
     m_amplitude = m_spellInfo->Effects[m_effIndex].Amplitude;
 
     // prepare periodics
@@ -577,6 +597,8 @@ void AuraEffect::CalculatePeriodic(Unit* caster, bool create, bool load)
                 m_periodicTimer += m_amplitude;
         }
     }
+
+    GetBase()->_RescheduleUpdate();
 }
 
 void AuraEffect::CalculateSpellMod()
@@ -625,7 +647,10 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
     if (handleMask & AURA_EFFECT_HANDLE_CHANGE_AMOUNT)
     {
         if (!mark)
+        {
             m_amount = newAmount;
+            InvalidateTargetsAuraModifierCache();
+        }
         else
             SetAmount(newAmount);
         CalculateSpellMod();
@@ -746,9 +771,43 @@ void AuraEffect::ApplySpellMod(Unit* target, bool apply)
     }
 }
 
+int32 AuraEffect::GetPeriodicTimer() const
+{
+    if (!IsPeriodicTimerRunning())
+        return m_periodicTimer;
+
+    return std::max(m_periodicTimer - int32(GetBase()->GetPendingUpdateTime()), 0);
+}
+
+void AuraEffect::SetPeriodicTimer(int32 periodicTimer)
+{
+    GetBase()->_SyncUpdateTime();
+    m_periodicTimer = periodicTimer;
+    GetBase()->_RescheduleUpdate();
+}
+
+void AuraEffect::ResetPeriodic(bool resetPeriodicTimer /*= false*/)
+{
+    if (resetPeriodicTimer)
+        SetPeriodicTimer(m_amplitude);
+    m_tickNumber = 0;
+}
+
+void AuraEffect::SetPeriodic(bool isPeriodic)
+{
+    GetBase()->_SyncUpdateTime();
+    m_isPeriodic = isPeriodic;
+    GetBase()->_RescheduleUpdate();
+}
+
+bool AuraEffect::IsPeriodicTimerRunning() const
+{
+    return m_isPeriodic && (GetBase()->GetDuration() >= 0 || GetBase()->IsPassive() || GetBase()->IsPermanent());
+}
+
 void AuraEffect::Update(uint32 diff, Unit* caster)
 {
-    if (m_isPeriodic && (GetBase()->GetDuration() >=0 || GetBase()->IsPassive() || GetBase()->IsPermanent()))
+    if (IsPeriodicTimerRunning())
     {
         if (m_periodicTimer > int32(diff))
             m_periodicTimer -= diff;
@@ -32,6 +32,7 @@ class AuraEffect
     friend void Aura::_InitEffects(uint8 effMask, Unit* caster, int32 *baseAmount);
     friend Aura* Unit::_TryStackingOrRefreshingExistingAura(SpellInfo const* newAura, uint8 effMask, Unit* caster, int32* baseAmount, Item* castItem, ObjectGuid casterGUID);
     friend Aura::~Aura();
+    friend void Aura::_SyncUpdateTime();
     private:
         ~AuraEffect();
         explicit AuraEffect(Aura* base, uint8 effIndex, int32 *baseAmount, Unit* caster);
@@ -53,10 +54,11 @@ class AuraEffect
         int32 GetMiscValue() const { return m_spellInfo->Effects[m_effIndex].MiscValue; }
         AuraType GetAuraType() const { return (AuraType)m_spellInfo->Effects[m_effIndex].ApplyAuraName; }
         int32 GetAmount() const { return m_amount; }
-        void SetAmount(int32 amount) { m_amount = amount; m_canBeRecalculated = false;}
+        void SetAmount(int32 amount);
 
-        int32 GetPeriodicTimer() const { return m_periodicTimer; }
-        void SetPeriodicTimer(int32 periodicTimer) { m_periodicTimer = periodicTimer; }
+        int32 GetPeriodicTimer() const;
+        void SetPeriodicTimer(int32 periodicTimer);
+        bool IsPeriodicTimerRunning() const;
 
         int32 CalculateAmount(Unit* caster);
         void CalculatePeriodic(Unit* caster, bool create = false, bool load = false);
@@ -82,10 +84,10 @@ class AuraEffect
 
         uint32 GetTickNumber() const { return m_tickNumber; }
         int32 GetTotalTicks() const { return m_amplitude ? (GetBase()->GetMaxDuration() / m_amplitude) : 1;}
-        void ResetPeriodic(bool resetPeriodicTimer = false) { if (resetPeriodicTimer) m_periodicTimer = m_amplitude; m_tickNumber = 0;}
+        void ResetPeriodic(bool resetPeriodicTimer = false);
 
         bool IsPeriodic() const { return m_isPeriodic; }
-        void SetPeriodic(bool isPeriodic) { m_isPeriodic = isPeriodic; }
+        void SetPeriodic(bool isPeriodic);
         bool IsAffectedOnSpell(SpellInfo const* spell) const;
         bool HasSpellClassMask() const { return m_spellInfo->Effects[m_effIndex].SpellClassMask; }
 
@@ -120,6 +122,8 @@ class AuraEffect
         bool m_isPeriodic;
     private:
         bool CanPeriodicTickCrit(Unit const* caster) const;
+        // amount changed, cached aura modifier totals of the targets are outdated
+        void InvalidateTargetsAuraModifierCache();
 
     public:
         // aura effect apply/remove handlers
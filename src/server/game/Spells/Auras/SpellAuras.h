@@ -123,12 +123,21 @@ class Aura
         void UpdateOwner(uint32 diff, WorldObject* owner);
         void Update(uint32 diff, Unit* caster);
 
+        // Unit owned auras are updated only when a timer is due, the time elapsed since their last update is pending.
+        // Timer getters include the pending time, setters bring the timers up to date and reschedule the update.
+        uint32 GetPendingUpdateTime() const;
+        uint32 GetNextUpdateDelay() const;
+        void _SyncUpdateTime();
+        void _ScheduleUpdate(uint32 minDelay = 0);
+        void _RescheduleUpdate() { if (m_isUpdateScheduled) _ScheduleUpdate(); }
+        void _UnscheduleUpdate();
+
         time_t GetApplyTime() const { return m_applyTime; }
         int32 GetMaxDuration() const { return m_maxDuration; }
         void SetMaxDuration(int32 duration) { m_maxDuration = duration; }
         int32 CalcMaxDuration() const { return CalcMaxDuration(GetCaster()); }
         int32 CalcMaxDuration(Unit* caster) const;
-        int32 GetDuration() const { return m_duration; }
+        int32 GetDuration() const;
         void SetDuration(int32 duration, bool withMods = false);
         void RefreshDuration(bool withMods = false);
         void RefreshTimers();
@@ -255,6 +264,8 @@ class Aura
         int32 m_duration;                                   // Current time
         int32 m_timeCla;                                    // Timer for power per sec calcultion
         int32 m_updateTargetMapInterval;                    // Timer for UpdateTargetMapOfEffect
+        uint64 m_lastUpdateTime;                            // Owner aura update time the timers are up to date for
+        Unit::AuraUpdateQueue::iterator m_updateQueueItr;
 
         uint8 const m_casterLevel;                          // Aura level (store caster level for correct show level dep amount)
         uint8 m_procCharges;                                // Aura charges (0 for infinite)
@@ -266,6 +277,7 @@ class Aura
         bool m_isRemoved:1;
         bool m_isSingleTarget:1;                        // true if it's a single target spell and registered at caster - can change at spell steal for example
         bool m_isUsingCharges:1;
+        bool m_isUpdateScheduled:1;
 
         ChargeDropEvent* m_dropEvent;
 
@@ -24,6 +24,8 @@
 #include "ObjectMgr.h"
 #include "SpellInfo.h"
 #include "PathGenerator.h"
+#include "FlatList.h"
+#include "FreeListPool.h"
 
 class Unit;
 class Player;
@@ -355,6 +357,10 @@ class Spell
         Spell(Unit* caster, SpellInfo const* info, TriggerCastFlags triggerFlags, ObjectGuid originalCasterGUID = ObjectGuid::Empty, bool skipCheck = false);
         ~Spell();
 
+        // created for every cast, the memory is reused through a per thread pool
+        static void* operator new(size_t size) { return FreeListPool<Spell>::Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { FreeListPool<Spell>::Free(ptr, size); }
+
         void InitExplicitTargets(SpellCastTargets const& targets);
         void SelectExplicitTargets();
 
@@ -593,7 +599,12 @@ class Spell
             bool   scaleAura:1;
             int32  damage;
         };
-        std::list<TargetInfo> m_UniqueTargetInfo;
+        // the nodes of both are reused through per thread pools like the Spell itself
+        typedef std::list<TargetInfo, FreeListAllocator<TargetInfo> > TargetInfoList;
+        typedef std::unordered_map<ObjectGuid, TargetInfo*, std::hash<ObjectGuid>, std::equal_to<ObjectGuid>,
+            FreeListAllocator<std::pair<ObjectGuid const, TargetInfo*> > > TargetInfoIndex;
+        TargetInfoList m_UniqueTargetInfo;
+        TargetInfoIndex m_UniqueTargetIndex;                    // m_UniqueTargetInfo by target, AoE spells add hundreds of targets
         uint8 m_channelTargetEffectMask;                        // Mask req. alive targets
 
         struct GOTargetInfo
@@ -603,14 +614,14 @@ class Spell
             uint8  effectMask:8;
             bool   processed:1;
         };
-        std::list<GOTargetInfo> m_UniqueGOTargetInfo;
+        FlatList<GOTargetInfo> m_UniqueGOTargetInfo;
 
         struct ItemTargetInfo
         {
             Item  *item;
             uint8 effectMask;
         };
-        std::list<ItemTargetInfo> m_UniqueItemInfo;
+        FlatList<ItemTargetInfo> m_UniqueItemInfo;
 
         SpellDestination m_destTargets[MAX_SPELL_EFFECTS];
 
@@ -631,6 +642,7 @@ class Spell
 
         void PrepareTargetProcessing();
         void FinishTargetProcessing();
+        Unit* m_spellBonusBatchCasters[2];                      // units batching their spell power between the two above
 
         // spell execution log
         void InitEffectExecuteData(uint8 effIndex);
@@ -760,6 +772,9 @@ class SpellEvent : public BasicEvent
         SpellEvent(Spell* spell);
         virtual ~SpellEvent();
 
+        static void* operator new(size_t size) { return FreeListPool<SpellEvent>::Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { FreeListPool<SpellEvent>::Free(ptr, size); }
+
         virtual bool Execute(uint64 e_time, uint32 p_time) override;
         virtual void Abort(uint64 e_time) override;
         virtual bool IsDeletable() const override;
@@ -835,11 +835,8 @@ SpellInfo::SpellInfo(SpellEntry const* spellEntry)
 
     SpellIconID = spellEntry->SpellIconID;
     ActiveIconID = spellEntry->activeIconID;
-    for (uint8 i = 0; i < 16; ++i)
-        SpellName[i] = spellEntry->SpellName[i];
-
-    for (uint8 i = 0; i < 16; ++i)
-        Rank[i] = spellEntry->Rank[i];
+    SpellName = spellEntry->SpellName;
+    Rank = spellEntry->Rank;
 
     MaxTargetLevel = spellEntry->MaxTargetLevel;
     MaxAffectedTargets = spellEntry->MaxAffectedTargets;
@@ -854,6 +851,8 @@ SpellInfo::SpellInfo(SpellEntry const* spellEntry)
 
     ChainEntry = NULL;
     ExplicitTargetMask = 0;
+    SpellScriptHookMask = 0;
+    AuraScriptHookMask = 0;
 	accountWide = false;
 }
 
@@ -292,10 +292,8 @@ private:
 class SpellInfo
 {
 public:
+    // Fields read on every cast, proc and aura check come first so they share cache lines
     uint32 Id;
-    SpellCategoryEntry const* CategoryEntry;
-    uint32 Dispel;
-    uint32 Mechanic;
     uint32 Attributes;
     uint32 AttributesEx;
     uint32 AttributesEx2;
@@ -305,12 +303,28 @@ public:
     uint32 AttributesEx6;
     uint32 AttributesEx7;
     uint32 AttributesCu;
+    uint32 SchoolMask;
+    uint32 DmgClass;
+    uint32 SpellFamilyName;
+    flag96 SpellFamilyFlags;
+    uint32 InterruptFlags;
+    uint32 AuraInterruptFlags;
+    uint32 ChannelInterruptFlags;
+    uint32 ProcFlags;
+    uint32 ProcChance;
+    uint32 ProcCharges;
+    uint32 Dispel;
+    uint32 Mechanic;
+    uint32 ExplicitTargetMask;
+    uint32 SpellScriptHookMask;                         // SpellScriptHookType bits registered by the spell scripts of the spell, 0 if none
+    uint32 AuraScriptHookMask;                          // AuraScriptHookType bits, same for aura scripts
+    SpellRangeEntry const* RangeEntry;
+    SpellCastTimesEntry const* CastTimeEntry;
+    SpellDurationEntry const* DurationEntry;
+    SpellCategoryEntry const* CategoryEntry;
+    SpellChainNode const* ChainEntry;
     uint32 Stances;
     uint32 StancesNot;
-    uint32 Targets;
-    uint32 TargetCreatureType;
-    uint32 RequiresSpellFocus;
-    uint32 FacingCasterFlags;
     uint32 CasterAuraState;
     uint32 TargetAuraState;
     uint32 CasterAuraStateNot;
@@ -319,21 +333,10 @@ public:
     uint32 TargetAuraSpell;
     uint32 ExcludeCasterAuraSpell;
     uint32 ExcludeTargetAuraSpell;
-    SpellCastTimesEntry const* CastTimeEntry;
     uint32 RecoveryTime;
     uint32 CategoryRecoveryTime;
     uint32 StartRecoveryCategory;
     uint32 StartRecoveryTime;
-    uint32 InterruptFlags;
-    uint32 AuraInterruptFlags;
-    uint32 ChannelInterruptFlags;
-    uint32 ProcFlags;
-    uint32 ProcChance;
-    uint32 ProcCharges;
-    uint32 MaxLevel;
-    uint32 BaseLevel;
-    uint32 SpellLevel;
-    SpellDurationEntry const* DurationEntry;
     uint32 PowerType;
     uint32 ManaCost;
     uint32 ManaCostPerlevel;
@@ -341,32 +344,33 @@ public:
     uint32 ManaPerSecondPerLevel;
     uint32 ManaCostPercentage;
     uint32 RuneCostID;
-    SpellRangeEntry const* RangeEntry;
+    uint32 MaxLevel;
+    uint32 BaseLevel;
+    uint32 SpellLevel;
     float  Speed;
     uint32 StackAmount;
-    uint32 Totem[2];
-    int32  Reagent[MAX_SPELL_REAGENTS];
-    uint32 ReagentCount[MAX_SPELL_REAGENTS];
+    uint32 MaxAffectedTargets;
     int32  EquippedItemClass;
     int32  EquippedItemSubClassMask;
     int32  EquippedItemInventoryTypeMask;
+    SpellEffectInfo Effects[MAX_SPELL_EFFECTS];
+    // Rarely used fields
+    uint32 Targets;
+    uint32 TargetCreatureType;
+    uint32 RequiresSpellFocus;
+    uint32 FacingCasterFlags;
+    uint32 Totem[2];
+    int32  Reagent[MAX_SPELL_REAGENTS];
+    uint32 ReagentCount[MAX_SPELL_REAGENTS];
     uint32 TotemCategory[2];
     uint32 SpellVisual[2];
     uint32 SpellIconID;
     uint32 ActiveIconID;
-    char* SpellName[16];
-    char* Rank[16];
+    char* const* SpellName;                                 // [locale], stored in the DBC entry
+    char* const* Rank;                                      // [locale], stored in the DBC entry
     uint32 MaxTargetLevel;
-    uint32 MaxAffectedTargets;
-    uint32 SpellFamilyName;
-    flag96 SpellFamilyFlags;
-    uint32 DmgClass;
     uint32 PreventionType;
     int32  AreaGroupId;
-    uint32 SchoolMask;
-    SpellEffectInfo Effects[MAX_SPELL_EFFECTS];
-    uint32 ExplicitTargetMask;
-    SpellChainNode const* ChainEntry;
 	bool accountWide;
     SpellInfo(SpellEntry const* spellEntry);
     ~SpellInfo();
@@ -386,6 +390,12 @@ public:
     inline bool HasAttribute(SpellAttr7 attribute) const { return !!(AttributesEx7 & attribute); }
     inline bool HasAttribute(SpellCustomAttributes customAttribute) const { return !!(AttributesCu & customAttribute); }
 
+    // Set by ObjectMgr::ValidateSpellScripts, lets unscripted spells skip script loading and hook calls
+    bool HasSpellScripts() const { return SpellScriptHookMask != 0; }
+    bool HasAuraScripts() const { return AuraScriptHookMask != 0; }
+    bool HasSpellScriptHook(uint8 hookType) const { return (SpellScriptHookMask & (1 << hookType)) != 0; }
+    bool HasAuraScriptHook(uint8 hookType) const { return (AuraScriptHookMask & (1 << hookType)) != 0; }
+
     bool IsExplicitDiscovery() const;
     bool IsLootCrafting() const;
     bool IsQuestTame() const;
@@ -346,7 +346,7 @@ bool IsDiminishingReturnsGroupDurationLimited(DiminishingGroup group)
     }
 }
 
-SpellMgr::SpellMgr() { }
+SpellMgr::SpellMgr() : mSpellInfoStorage(NULL), mSpellInfoStorageSize(0) { }
 
 SpellMgr::~SpellMgr()
 {
@@ -2737,17 +2737,30 @@ void SpellMgr::LoadSpellInfoStore()
     UnloadSpellInfoStore();
     mSpellInfoMap.resize(sSpellStore.GetNumRows(), NULL);
 
+    // One contiguous block instead of one heap allocation per spell, spells with close ids
+    // (ranks, talents, triggered spells) are close in memory too
+    uint32 count = 0;
+    for (uint32 i = 0; i < sSpellStore.GetNumRows(); ++i)
+        if (sSpellStore.LookupEntry(i))
+            ++count;
+
+    mSpellInfoStorage = static_cast<SpellInfo*>(::operator new(count * sizeof(SpellInfo)));
+
     for (uint32 i = 0; i < sSpellStore.GetNumRows(); ++i)
         if (SpellEntry const* spellEntry = sSpellStore.LookupEntry(i))
-            mSpellInfoMap[i] = new SpellInfo(spellEntry);
+            mSpellInfoMap[i] = new (&mSpellInfoStorage[mSpellInfoStorageSize++]) SpellInfo(spellEntry);
 
     TC_LOG_INFO("server.loading", ">> Loaded SpellInfo store in %u ms", GetMSTimeDiffToNow(oldMSTime));
 }
 
 void SpellMgr::UnloadSpellInfoStore()
 {
-    for (uint32 i = 0; i < GetSpellInfoStoreSize(); ++i)
-        delete mSpellInfoMap[i];
+    for (uint32 i = 0; i < mSpellInfoStorageSize; ++i)
+        mSpellInfoStorage[i].~SpellInfo();
+
+    ::operator delete(mSpellInfoStorage);
+    mSpellInfoStorage = NULL;
+    mSpellInfoStorageSize = 0;
 
     mSpellInfoMap.clear();
 }
@@ -771,6 +771,8 @@ class SpellMgr
         PetLevelupSpellMap         mPetLevelupSpellMap;
         PetDefaultSpellsMap        mPetDefaultSpellsMap;           // only spells not listed in related mPetLevelupSpellMap entry
         SpellInfoMap               mSpellInfoMap;
+        SpellInfo*                 mSpellInfoStorage;              // all SpellInfo objects, ordered by id, mSpellInfoMap points into it
+        uint32                     mSpellInfoStorageSize;
 };
 
 #define sSpellMgr SpellMgr::instance()
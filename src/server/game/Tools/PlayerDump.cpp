@@ -21,6 +21,7 @@
 #include "DatabaseEnv.h"
 #include "UpdateFields.h"
 #include "ObjectMgr.h"
+#include "CharacterCache.h"
 #include "AccountMgr.h"
 #include "World.h"
 
@@ -674,7 +675,7 @@ DumpReturn PlayerDumpReader::LoadDump(std::string const& file, uint32 account, s
     CharacterDatabase.CommitTransaction(trans);
 
     // in case of name conflict player has to rename at login anyway
-    sWorld->AddCharacterNameData(ObjectGuid(HIGHGUID_PLAYER, guid), name, gender, race, playerClass, level);
+    sCharacterCache->AddCharacterCacheEntry(ObjectGuid(HIGHGUID_PLAYER, guid), account, name, gender, race, playerClass, level);
 
     sObjectMgr->_hiItemGuid += items.size();
     sObjectMgr->_mailId     += mails.size();
@@ -29,6 +29,7 @@
 #include "BattlegroundMgr.h"
 #include "CalendarMgr.h"
 #include "Channel.h"
+#include "CharacterCache.h"
 #include "CharacterDatabaseCleaner.h"
 #include "Chat.h"
 #include "Config.h"
@@ -116,6 +117,8 @@ World::World()
 
     m_CleaningFlags = 0;
 
+    m_queryCompletionQueue = std::make_shared<SQLQueryCompletionQueue>();
+
     memset(rate_values, 0, sizeof(rate_values));
     memset(m_int_configs, 0, sizeof(m_int_configs));
     memset(m_bool_configs, 0, sizeof(m_bool_configs));
@@ -290,6 +293,22 @@ void World::AddSession_(WorldSession* s)
     }
 }
 
+bool World::HasRecentLogoutSave(uint32 accountId)
+{
+    for (LogoutSaveMap::iterator i = m_logoutSaves.begin(); i != m_logoutSaves.end();)
+    {
+        if (time(NULL) - i->second < LOGOUT_SAVE_PENDING_TIME)
+        {
+            if (i->first == accountId)
+                return true;
+            ++i;
+        }
+        else
+            m_logoutSaves.erase(i++);
+    }
+    return false;
+}
+
 bool World::HasRecentlyDisconnected(WorldSession* session)
 {
     if (!session)
@@ -597,6 +616,7 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_PRESERVE_CUSTOM_CHANNELS] = sConfigMgr->GetBoolDefault("PreserveCustomChannels", false);
     m_int_configs[CONFIG_PRESERVE_CUSTOM_CHANNEL_DURATION] = sConfigMgr->GetIntDefault("PreserveCustomChannelDuration", 14);
     m_bool_configs[CONFIG_GRID_UNLOAD] = sConfigMgr->GetBoolDefault("GridUnload", true);
+    m_bool_configs[CONFIG_GRID_PACK_FLOAT_HEIGHTS] = sConfigMgr->GetBoolDefault("GridPackFloatHeights", false);
     m_int_configs[CONFIG_INTERVAL_SAVE] = sConfigMgr->GetIntDefault("PlayerSaveInterval", 15 * MINUTE * IN_MILLISECONDS);
     m_int_configs[CONFIG_INTERVAL_DISCONNECT_TOLERANCE] = sConfigMgr->GetIntDefault("DisconnectToleranceInterval", 0);
     m_bool_configs[CONFIG_STATS_SAVE_ONLY_ON_LOGOUT] = sConfigMgr->GetBoolDefault("PlayerSave.Stats.SaveOnlyOnLogout", true);
@@ -736,6 +756,8 @@ void World::LoadConfigSettings(bool reload)
         m_int_configs[CONFIG_SKIP_CINEMATICS] = 0;
     }
 
+    m_int_configs[CONFIG_CHARACTER_LOGIN_PREFETCH_TIMEOUT] = sConfigMgr->GetIntDefault("CharacterLogin.PrefetchTimeout", 10000);
+
     if (reload)
     {
         uint32 val = sConfigMgr->GetIntDefault("MaxPlayerLevel", DEFAULT_MAX_LEVEL);
@@ -1176,6 +1198,8 @@ void World::LoadConfigSettings(bool reload)
     }
 
     m_bool_configs[CONFIG_ENABLE_MMAPS] = sConfigMgr->GetBoolDefault("mmap.enablePathFinding", false);
+    m_int_configs[CONFIG_PATHFINDING_THREADS] = sConfigMgr->GetIntDefault("mmap.pathFindingThreads", 0);
+    m_bool_configs[CONFIG_FLOW_FIELD_CHASE] = sConfigMgr->GetBoolDefault("mmap.flowFieldChase", false);
     TC_LOG_INFO("server.loading", "WORLD: MMap data directory is: %smmaps", m_dataPath.c_str());
 
     m_bool_configs[CONFIG_VMAP_INDOOR_CHECK] = sConfigMgr->GetBoolDefault("vmap.enableIndoorCheck", 0);
@@ -1212,6 +1236,7 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = sConfigMgr->GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = sConfigMgr->GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_MAP_PREFETCH_THREADS] = sConfigMgr->GetIntDefault("MapPrefetch.Threads", 0);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1887,7 +1912,19 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Calculate guild limitation(s) reset time...");
     InitGuildResetTime();
 
-    LoadCharacterNameData();
+    TC_LOG_INFO("server.loading", "Loading character cache...");
+    sCharacterCache->LoadCharacterCacheStorage();
+
+    // Clients cache names and appearance of other characters
+    sCharacterCache->RegisterListener([this](ObjectGuid guid, uint32 updateFlags)
+    {
+        if (!(updateFlags & (CHARACTER_CACHE_NAME | CHARACTER_CACHE_APPEARANCE)))
+            return;
+
+        WorldPacket data(SMSG_INVALIDATE_PLAYER, 8);
+        data << guid;
+        SendGlobalMessage(&data);
+    });
 
 #ifdef ELUNA
     ///- Run eluna scripts.
@@ -2816,7 +2853,7 @@ void World::UpdateRealmCharCount(uint32 accountId)
 {
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_COUNT);
     stmt->setUInt32(0, accountId);
-    m_realmCharCallbacks.push_back(CharacterDatabase.AsyncQuery(stmt));
+    CharacterDatabase.AsyncQuery(stmt, m_queryCompletionQueue, [this](PreparedQueryResult result) { _UpdateRealmCharCount(result); });
 }
 
 void World::_UpdateRealmCharCount(PreparedQueryResult resultCharCount)
@@ -3171,112 +3208,7 @@ uint64 World::getWorldState(uint32 index) const
 
 void World::ProcessQueryCallbacks()
 {
-    PreparedQueryResult result;
-
-    for (std::deque<std::future<PreparedQueryResult>>::iterator itr = m_realmCharCallbacks.begin(); itr != m_realmCharCallbacks.end(); )
-    {
-        if ((*itr).wait_for(std::chrono::seconds(0)) != std::future_status::ready)
-        {
-            ++itr;
-            continue;
-        }
-
-        result = (*itr).get();
-        _UpdateRealmCharCount(result);
-        itr = m_realmCharCallbacks.erase(itr);
-    }
-}
-
-/**
-* @brief Loads several pieces of information on server startup with the GUID
-* There is no further database query necessary.
-* These are a number of methods that work into the calling function.
-*
-* @param guid Requires a guid to call
-* @return Name, Gender, Race, Class and Level of player character
-* Example Usage:
-* @code
-*    CharacterNameData const* nameData = sWorld->GetCharacterNameData(GUID);
-*    if (!nameData)
-*        return;
-*
-* std::string playerName = nameData->m_name;
-* uint8 playerGender = nameData->m_gender;
-* uint8 playerRace = nameData->m_race;
-* uint8 playerClass = nameData->m_class;
-* uint8 playerLevel = nameData->m_level;
-* @endcode
-**/
-
-void World::LoadCharacterNameData()
-{
-    TC_LOG_INFO("server.loading", "Loading character name data");
-
-    QueryResult result = CharacterDatabase.Query("SELECT guid, name, race, gender, class, level FROM characters WHERE deleteDate IS NULL");
-    if (!result)
-    {
-        TC_LOG_INFO("server.loading", "No character name data loaded, empty query");
-        return;
-    }
-
-    uint32 count = 0;
-
-    do
-    {
-        Field* fields = result->Fetch();
-        AddCharacterNameData(ObjectGuid(HIGHGUID_PLAYER, fields[0].GetUInt32()), fields[1].GetString(),
-            fields[3].GetUInt8() /*gender*/, fields[2].GetUInt8() /*race*/, fields[4].GetUInt8() /*class*/, fields[5].GetUInt8() /*level*/);
-        ++count;
-    } while (result->NextRow());
-
-    TC_LOG_INFO("server.loading", "Loaded name data for %u characters", count);
-}
-
-void World::AddCharacterNameData(ObjectGuid guid, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level)
-{
-    CharacterNameData& data = _characterNameDataMap[guid];
-    data.m_name = name;
-    data.m_race = race;
-    data.m_gender = gender;
-    data.m_class = playerClass;
-    data.m_level = level;
-}
-
-void World::UpdateCharacterNameData(ObjectGuid guid, std::string const& name, uint8 gender /*= GENDER_NONE*/, uint8 race /*= RACE_NONE*/)
-{
-    std::map<ObjectGuid, CharacterNameData>::iterator itr = _characterNameDataMap.find(guid);
-    if (itr == _characterNameDataMap.end())
-        return;
-
-    itr->second.m_name = name;
-
-    if (gender != GENDER_NONE)
-        itr->second.m_gender = gender;
-
-    if (race != RACE_NONE)
-        itr->second.m_race = race;
-
-    WorldPacket data(SMSG_INVALIDATE_PLAYER, 8);
-    data << guid;
-    SendGlobalMessage(&data);
-}
-
-void World::UpdateCharacterNameDataLevel(ObjectGuid guid, uint8 level)
-{
-    std::map<ObjectGuid, CharacterNameData>::iterator itr = _characterNameDataMap.find(guid);
-    if (itr == _characterNameDataMap.end())
-        return;
-
-    itr->second.m_level = level;
-}
-
-CharacterNameData const* World::GetCharacterNameData(ObjectGuid guid) const
-{
-    std::map<ObjectGuid, CharacterNameData>::const_iterator itr = _characterNameDataMap.find(guid);
-    if (itr != _characterNameDataMap.end())
-        return &itr->second;
-    else
-        return NULL;
+    m_queryCompletionQueue->ProcessReadyCallbacks();
 }
 
 void World::ReloadRBAC()
@@ -29,6 +29,7 @@
 #include "SharedDefines.h"
 #include "QueryResult.h"
 #include "Callback.h"
+#include "QueryCompletionQueue.h"
 
 #include <atomic>
 #include <map>
@@ -43,6 +44,7 @@ class WorldSocket;
 class SystemMgr;
 
 #define WS_DEATH_RESET_TIME 20002                    // Custom worldstate
+#define LOGOUT_SAVE_PENDING_TIME 30                  // seconds a logout save may wait in the character database queue
 
 // ServerMessages.dbc
 enum ServerMessageType
@@ -92,6 +94,7 @@ enum WorldBoolConfigs
     CONFIG_ALLOW_PLAYER_COMMANDS,
     CONFIG_CLEAN_CHARACTER_DB,
     CONFIG_GRID_UNLOAD,
+    CONFIG_GRID_PACK_FLOAT_HEIGHTS,
     CONFIG_STATS_SAVE_ONLY_ON_LOGOUT,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_CALENDAR,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_CHANNEL,
@@ -154,6 +157,7 @@ enum WorldBoolConfigs
     CONFIG_QUEST_ENABLE_QUEST_TRACKER,
     CONFIG_WARDEN_ENABLED,
     CONFIG_ENABLE_MMAPS,
+    CONFIG_FLOW_FIELD_CHASE,
     CONFIG_WINTERGRASP_ENABLE,
     CONFIG_UI_QUESTLEVELS_IN_DIALOGS,     // Should we add quest levels to the title in the NPC dialogs?
     CONFIG_EVENT_ANNOUNCE,
@@ -213,6 +217,7 @@ enum WorldIntConfigs
     CONFIG_HEROIC_CHARACTERS_PER_REALM,
     CONFIG_CHARACTER_CREATING_MIN_LEVEL_FOR_HEROIC_CHARACTER,
     CONFIG_SKIP_CINEMATICS,
+    CONFIG_CHARACTER_LOGIN_PREFETCH_TIMEOUT,
     CONFIG_MAX_PLAYER_LEVEL,
     CONFIG_MIN_DUALSPEC_LEVEL,
     CONFIG_START_PLAYER_LEVEL,
@@ -298,6 +303,8 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_PATHFINDING_THREADS,
+    CONFIG_MAP_PREFETCH_THREADS,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -533,15 +540,6 @@ private:
 
 typedef std::unordered_map<uint32, WorldSession*> SessionMap;
 
-struct CharacterNameData
-{
-    std::string m_name;
-    uint8 m_class;
-    uint8 m_race;
-    uint8 m_gender;
-    uint8 m_level;
-};
-
 /// The World
 class World
 {
@@ -602,6 +600,10 @@ class World
         int32 GetQueuePos(WorldSession*);
         bool HasRecentlyDisconnected(WorldSession*);
 
+        /// Character saves of an account on logout are queued, its next login must not be loaded ahead of them
+        void AddLogoutSave(uint32 accountId) { m_logoutSaves[accountId] = time(NULL); }
+        bool HasRecentLogoutSave(uint32 accountId);
+
         /// @todo Actions on m_allowMovement still to be implemented
         /// Is movement allowed?
         bool getAllowMovement() const { return m_allowMovement; }
@@ -759,13 +761,6 @@ class World
 
         void UpdateAreaDependentAuras();
 
-        CharacterNameData const* GetCharacterNameData(ObjectGuid guid) const;
-        void AddCharacterNameData(ObjectGuid guid, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level);
-        void UpdateCharacterNameData(ObjectGuid guid, std::string const& name, uint8 gender = GENDER_NONE, uint8 race = RACE_NONE);
-        void UpdateCharacterNameDataLevel(ObjectGuid guid, uint8 level);
-        void DeleteCharacterNameData(ObjectGuid guid) { _characterNameDataMap.erase(guid); }
-        bool HasCharacterNameData(ObjectGuid guid) { return _characterNameDataMap.find(guid) != _characterNameDataMap.end(); }
-
         uint32 GetCleaningFlags() const { return m_CleaningFlags; }
         void   SetCleaningFlags(uint32 flags) { m_CleaningFlags = flags; }
         void   ResetEventSeasonalQuests(uint16 event_id);
@@ -813,6 +808,8 @@ class World
         SessionMap m_sessions;
         typedef std::unordered_map<uint32, time_t> DisconnectMap;
         DisconnectMap m_disconnects;
+        typedef std::unordered_map<uint32, time_t> LogoutSaveMap;
+        LogoutSaveMap m_logoutSaves;
         uint32 m_maxActiveSessionCount;
         uint32 m_maxQueuedSessionCount;
         uint32 m_PlayerCount;
@@ -870,11 +867,8 @@ class World
         typedef std::map<uint8, uint8> AutobroadcastsWeightMap;
         AutobroadcastsWeightMap m_AutobroadcastsWeights;
 
-        std::map<ObjectGuid, CharacterNameData> _characterNameDataMap;
-        void LoadCharacterNameData();
-
         void ProcessQueryCallbacks();
-        std::deque<std::future<PreparedQueryResult>> m_realmCharCallbacks;
+        SQLQueryCompletionQueuePtr m_queryCompletionQueue;
 		time_t nextDeathReset;
 };
 
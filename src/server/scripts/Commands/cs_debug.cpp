@@ -33,6 +33,11 @@ EndScriptData */
 #include "GossipDef.h"
 #include "Transport.h"
 #include "Language.h"
+#include "Spell.h"
+#include "SpellMgr.h"
+#include "Timer.h"
+#include "VMapFactory.h"
+#include "VMapManager2.h"
 
 #include <fstream>
 
@@ -93,6 +98,7 @@ public:
             { "los",           rbac::RBAC_PERM_COMMAND_DEBUG_LOS,           false, &HandleDebugLoSCommand,              "", NULL },
             { "moveflags",     rbac::RBAC_PERM_COMMAND_DEBUG_MOVEFLAGS,     false, &HandleDebugMoveflagsCommand,        "", NULL },
             { "transport",     rbac::RBAC_PERM_COMMAND_DEBUG_TRANSPORT,     false, &HandleDebugTransportCommand,        "", NULL },
+            { "combat",        rbac::RBAC_PERM_COMMAND_DEBUG_COMBAT,        false, &HandleDebugCombatCommand,           "", NULL },
             { NULL,            0,                                     false, NULL,                                "", NULL }
         };
         static ChatCommand commandTable[] =
@@ -815,6 +821,190 @@ public:
         return true;
     }
 
+    static void SendBenchmarkResult(ChatHandler* handler, char const* name, uint64 elapsedUS, uint32 iterations)
+    {
+        handler->PSendSysMessage("  %-24s %10.1f ns/op", name, double(elapsedUS) * 1000.0 / iterations);
+    }
+
+    // Time the combat formulas of the player against the selected unit, with the auras both currently have
+    // .debug combat #spellid [#iterations]
+    static bool HandleDebugCombatCommand(ChatHandler* handler, char const* args)
+    {
+        if (!*args)
+            return false;
+
+        char* spellStr = strtok((char*)args, " ");
+        char* countStr = strtok(NULL, " ");
+
+        uint32 spellId = handler->extractSpellIdFromLink(spellStr);
+        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellId);
+        if (!spellInfo)
+        {
+            handler->PSendSysMessage(LANG_COMMAND_NOSPELLFOUND);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        // every section runs on the world thread, more iterations would stall the server noticeably
+        uint32 iterations = countStr ? atoi(countStr) : 1000;
+        if (!iterations || iterations > 10000)
+            return false;
+
+        Player* player = handler->GetSession()->GetPlayer();
+        Unit* target = handler->getSelectedUnit();
+        if (!target)
+        {
+            handler->SendSysMessage(LANG_SELECT_CHAR_OR_CREATURE);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        // results are summed up so the calls can not be optimized away
+        uint64 checksum = 0;
+
+        handler->PSendSysMessage("Combat benchmark of %s against %s, spell %u, %u iterations (%u/%u applied auras)",
+            player->GetName().c_str(), target->GetName().c_str(), spellInfo->Id, iterations,
+            uint32(player->GetAppliedAuras().size()), uint32(target->GetAppliedAuras().size()));
+
+        // CalcAbsorbResist, also called by CalculateMeleeDamage, uses up absorbs, runs their scripts and deals split
+        // damage like in combat, so both are only measured against targets without such auras
+        bool absorbs = target->HasAuraType(SPELL_AURA_SCHOOL_ABSORB) || target->HasAuraType(SPELL_AURA_MANA_SHIELD) ||
+            target->HasAuraType(SPELL_AURA_SPLIT_DAMAGE_FLAT) || target->HasAuraType(SPELL_AURA_SPLIT_DAMAGE_PCT);
+
+        uint64 startTime;
+        if (!absorbs)
+        {
+            startTime = getUSTime();
+            for (uint32 i = 0; i < iterations; ++i)
+            {
+                CalcDamageInfo damageInfo;
+                player->CalculateMeleeDamage(target, 0, &damageInfo, BASE_ATTACK);
+                checksum += damageInfo.damage;
+            }
+            SendBenchmarkResult(handler, "CalculateMeleeDamage", GetUSTimeDiffToNow(startTime), iterations);
+        }
+
+        startTime = getUSTime();
+        for (uint32 i = 0; i < iterations; ++i)
+            checksum += player->SpellDamageBonusDone(target, spellInfo, 1000, SPELL_DIRECT_DAMAGE);
+        SendBenchmarkResult(handler, "SpellDamageBonusDone", GetUSTimeDiffToNow(startTime), iterations);
+
+        if (!absorbs)
+        {
+            startTime = getUSTime();
+            for (uint32 i = 0; i < iterations; ++i)
+            {
+                uint32 absorb = 0;
+                uint32 resist = 0;
+                player->CalcAbsorbResist(target, spellInfo->GetSchoolMask(), SPELL_DIRECT_DAMAGE, 1000, &absorb, &resist, spellInfo);
+                checksum += absorb + resist;
+            }
+            SendBenchmarkResult(handler, "CalcAbsorbResist", GetUSTimeDiffToNow(startTime), iterations);
+        }
+        else
+            handler->SendSysMessage("  CalculateMeleeDamage, CalcAbsorbResist: skipped, the target has absorb or split damage auras");
+
+        startTime = getUSTime();
+        for (uint32 i = 0; i < iterations; ++i)
+            checksum += uint64(player->GetTotalAuraMultiplierByMiscMask(SPELL_AURA_MOD_DAMAGE_PERCENT_DONE, spellInfo->GetSchoolMask()) * 1000.0f);
+        SendBenchmarkResult(handler, "GetTotalAuraMultiplier", GetUSTimeDiffToNow(startTime), iterations);
+
+        // proc selection of a melee hit, for the player as attacker and the target as victim, once from the proc index
+        // and once from all applied auras like before the index; the procs themselves are not triggered
+        for (uint8 pass = 0; pass < 2; ++pass)
+        {
+            bool useIndex = pass == 0;
+            startTime = getUSTime();
+            for (uint32 i = 0; i < iterations; ++i)
+            {
+                checksum += player->CountProcCandidates(false, target, PROC_FLAG_DONE_MELEE_AUTO_ATTACK, PROC_EX_NORMAL_HIT, BASE_ATTACK, useIndex);
+                checksum += target->CountProcCandidates(true, player, PROC_FLAG_TAKEN_MELEE_AUTO_ATTACK, PROC_EX_NORMAL_HIT, BASE_ATTACK, useIndex);
+            }
+            SendBenchmarkResult(handler, useIndex ? "Proc selection, index" : "Proc selection, all auras", GetUSTimeDiffToNow(startTime), iterations);
+        }
+
+        FreeListPoolStats poolStats = FreeListPool<Spell>::GetStats();
+        startTime = getUSTime();
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            Spell* spell = new Spell(player, spellInfo, TRIGGERED_NONE);
+            spell->m_targets.SetUnitTarget(target);
+            checksum += spell->CheckCast(true);
+            delete spell;
+        }
+        SendBenchmarkResult(handler, "Spell::CheckCast", GetUSTimeDiffToNow(startTime), iterations);
+
+        FreeListPoolStats newPoolStats = FreeListPool<Spell>::GetStats();
+        handler->PSendSysMessage("  Spell allocations: " UI64FMTD " from heap, " UI64FMTD " reused",
+            newPoolStats.HeapAllocations - poolStats.HeapAllocations, newPoolStats.Reuses - poolStats.Reuses);
+
+        if (target->CanHaveThreatList())
+        {
+            ThreatContainer::StorageType const& threatList = target->getThreatManager().getThreatList();
+
+            startTime = getUSTime();
+            for (uint32 i = 0; i < iterations; ++i)
+                checksum += uint64(target->getThreatManager().getThreat(player));
+            SendBenchmarkResult(handler, "Threat lookup", GetUSTimeDiffToNow(startTime), iterations);
+
+            // a linear search like getReferenceByTarget did before the index, but over the current list, it is not
+            // the implementation before the threat references were indexed
+            startTime = getUSTime();
+            for (uint32 i = 0; i < iterations; ++i)
+            {
+                for (ThreatContainer::StorageType::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
+                {
+                    if ((*itr)->getUnitGuid() == player->GetGUID())
+                    {
+                        checksum += uint64((*itr)->getThreat());
+                        break;
+                    }
+                }
+            }
+            SendBenchmarkResult(handler, "Threat list linear scan", GetUSTimeDiffToNow(startTime), iterations);
+
+            // move the player between the bottom and the top of the list, followed once by the incremental reorder and
+            // once by sorting a copy of the list like ThreatContainer::update did before the index, both times including
+            // the index update of the threat change itself; the threat of the player is restored afterwards
+            ThreatContainer& threatContainer = target->getThreatManager().getOnlineContainer();
+            HostileReference* ref = threatContainer.getReferenceByTarget(player);
+            if (ref && threatList.size() > 1)
+            {
+                float threat = ref->getThreat();
+                float topThreat = threatList.front()->getThreat() + 1.0f;
+
+                startTime = getUSTime();
+                for (uint32 i = 0; i < iterations; ++i)
+                {
+                    ref->setThreat(i & 1 ? 0.0f : topThreat);
+                    threatContainer.setDirty(true);
+                    threatContainer.update();
+                    checksum += uint64(threatList.front()->getThreat());
+                }
+                SendBenchmarkResult(handler, "Threat change, reorder", GetUSTimeDiffToNow(startTime), iterations);
+
+                ThreatContainer::StorageType sortedList(threatList);
+                startTime = getUSTime();
+                for (uint32 i = 0; i < iterations; ++i)
+                {
+                    ref->setThreat(i & 1 ? 0.0f : topThreat);
+                    sortedList.sort(Trinity::ThreatOrderPred());
+                    checksum += uint64(sortedList.front()->getThreat());
+                }
+                SendBenchmarkResult(handler, "Threat change, list sort", GetUSTimeDiffToNow(startTime), iterations);
+
+                ref->setThreat(threat);
+                threatContainer.setDirty(true);
+                threatContainer.update();
+            }
+
+            handler->PSendSysMessage("  Threat list size: %u", uint32(threatList.size()));
+        }
+
+        handler->PSendSysMessage("Checksum " UI64FMTD, checksum);
+        return true;
+    }
+
     static bool HandleDebugHostileRefListCommand(ChatHandler* handler, char const* /*args*/)
     {
         Unit* target = handler->getSelectedUnit();
@@ -1047,10 +1237,72 @@ public:
         return true;
     }
 
-    static bool HandleDebugLoSCommand(ChatHandler* handler, char const* /*args*/)
+    // .debug los [record [#count] | replay]
+    // record: keeps the next line of sight queries of all maps, replay: answers them again one by one and in packets
+    static bool HandleDebugLoSCommand(ChatHandler* handler, char const* args)
     {
+        char* mode = strtok((char*)args, " ");
+        if (mode && (!strcmp(mode, "record") || !strcmp(mode, "replay")))
+        {
+            VMAP::VMapManager2* vmgr = dynamic_cast<VMAP::VMapManager2*>(VMAP::VMapFactory::createOrGetVMapManager());
+            if (!vmgr)
+                return false;
+
+            if (!strcmp(mode, "record"))
+            {
+                char* countStr = strtok(NULL, " ");
+                // replay answers every query twice on the world thread, larger recordings would stall the server
+                uint32 count = countStr ? atoi(countStr) : 10000;
+                if (!count || count > 100000)
+                    return false;
+
+                vmgr->startLineOfSightRecording(count);
+                handler->PSendSysMessage("Recording the next %u line of sight queries", count);
+                return true;
+            }
+
+            std::vector<VMAP::LineOfSightQuery> queries;
+            vmgr->stopLineOfSightRecording(queries);
+            if (queries.empty())
+            {
+                handler->SendSysMessage("No line of sight queries recorded");
+                return true;
+            }
+
+            uint32 count = queries.size();
+            std::vector<bool> scalarResults(count);
+            uint64 startTime = getUSTime();
+            for (uint32 i = 0; i < count; ++i)
+            {
+                VMAP::LineOfSightQuery const& query = queries[i];
+                scalarResults[i] = vmgr->isInLineOfSight(query.MapId, query.Start.x, query.Start.y, query.Start.z, query.End.x, query.End.y, query.End.z);
+            }
+            uint64 scalarTime = GetUSTimeDiffToNow(startTime);
+
+            std::unique_ptr<bool[]> packetResults(new bool[count]);
+            startTime = getUSTime();
+            vmgr->isInLineOfSight(queries.data(), count, packetResults.get());
+            uint64 packetTime = GetUSTimeDiffToNow(startTime);
+
+            uint32 blocked = 0;
+            uint32 mismatches = 0;
+            for (uint32 i = 0; i < count; ++i)
+            {
+                blocked += !scalarResults[i];
+                mismatches += scalarResults[i] != packetResults[i];
+            }
+
+            handler->PSendSysMessage("Replayed %u line of sight queries, %u blocked, %u mismatches", count, blocked, mismatches);
+            SendBenchmarkResult(handler, "One by one", scalarTime, count);
+            SendBenchmarkResult(handler, "Packets", packetTime, count);
+            return true;
+        }
+
         if (Unit* unit = handler->getSelectedUnit())
             handler->PSendSysMessage("Unit %s (GuidLow: %u) is %sin LoS", unit->GetName().c_str(), unit->GetGUIDLow(), handler->GetSession()->GetPlayer()->IsWithinLOSInMap(unit) ? "" : "not ");
+
+        LineOfSightCacheStats stats = LineOfSightCache::GetStats();
+        handler->PSendSysMessage("LoS cache: %u hits, %u misses", uint32(stats.Hits), uint32(stats.Misses));
         return true;
     }
 
@@ -28,6 +28,7 @@
 #include "Opcodes.h"
 #include "SpellAuras.h"
 #include "TargetedMovementGenerator.h"
+#include "FlowFieldMovementGenerator.h"
 #include "WeatherMgr.h"
 #include "Player.h"
 #include "Pet.h"
@@ -2053,6 +2054,8 @@ public:
                     Unit* target = NULL;
                     if (unit->GetTypeId() == TYPEID_PLAYER)
                         target = static_cast<ChaseMovementGenerator<Player> const*>(movementGenerator)->GetTarget();
+                    else if (FlowFieldMovementGenerator<Creature> const* flowField = dynamic_cast<FlowFieldMovementGenerator<Creature> const*>(movementGenerator))
+                        target = flowField->GetTarget();
                     else
                         target = static_cast<ChaseMovementGenerator<Creature> const*>(movementGenerator)->GetTarget();
 
@@ -30,6 +30,9 @@
 #include "Player.h"
 #include "PointMovementGenerator.h"
 #include "PathGenerator.h"
+#include "PathfindingMgr.h"
+#include "FlowField.h"
+#include "TilePrefetcher.h"
 #include "MMapFactory.h"
 #include "Map.h"
 #include "TargetedMovementGenerator.h"
@@ -214,6 +217,20 @@ public:
 
         MMAP::MMapManager* manager = MMAP::MMapFactory::createOrGetMMapManager();
         handler->PSendSysMessage(" %u maps loaded with %u tiles overall", manager->getLoadedMapsCount(), manager->getLoadedTilesCount());
+        handler->PSendSysMessage(" %.2f MB of tile files mapped", float(manager->getMappedTilesSize()) / 1048576);
+
+        if (sTilePrefetcher->IsActive())
+            handler->PSendSysMessage(" " UI64FMTD " grids prefetched ahead of players, " UI64FMTD " picked up when their grid was loaded",
+                sTilePrefetcher->GetPrefetchCount(), sTilePrefetcher->GetHitCount());
+
+        if (sPathfindingMgr->IsActive())
+            handler->PSendSysMessage(" " UI64FMTD " path requests to pathfinding threads, " UI64FMTD " shared with an identical one",
+                sPathfindingMgr->GetRequestCount(), sPathfindingMgr->GetSharedRequestCount());
+
+        FlowFieldStats flowFieldStats = FlowField::GetStats();
+        if (flowFieldStats.Builds)
+            handler->PSendSysMessage(" " UI64FMTD " flow fields built, " UI64FMTD " paths taken from them, " UI64FMTD " followers outside",
+                flowFieldStats.Builds, flowFieldStats.Lookups, flowFieldStats.Misses);
 
         dtNavMesh const* navmesh = manager->GetNavMesh(handler->GetSession()->GetPlayer()->GetMapId());
         if (!navmesh)
@@ -222,6 +239,14 @@ public:
             return true;
         }
 
+        if (MMAP::PathCache* pathCache = manager->GetPathCache(mapId))
+        {
+            MMAP::PathCacheStats cacheStats = pathCache->GetStats();
+            uint64 lookups = cacheStats.Hits + cacheStats.Misses;
+            handler->PSendSysMessage(" path cache: " UI64FMTD " hits, " UI64FMTD " misses (findPath calls), %.1f%% hit rate",
+                cacheStats.Hits, cacheStats.Misses, lookups ? 100.0f * cacheStats.Hits / lookups : 0.0f);
+        }
+
         uint32 tileCount = 0;
         uint32 nodeCount = 0;
         uint32 polyCount = 0;
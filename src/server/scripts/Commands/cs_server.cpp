@@ -24,6 +24,7 @@ EndScriptData */
 
 #include "Chat.h"
 #include "Config.h"
+#include "DatabaseEnv.h"
 #include "Language.h"
 #include "ObjectAccessor.h"
 #include "Player.h"
@@ -77,6 +78,7 @@ public:
         static ChatCommand serverCommandTable[] =
         {
             { "corpses",      rbac::RBAC_PERM_COMMAND_SERVER_CORPSES,      true, &HandleServerCorpsesCommand, "", NULL },
+            { "dbstats",      rbac::RBAC_PERM_COMMAND_SERVER_DBSTATS,      true, &HandleServerDBStatsCommand, "", NULL },
             { "exit",         rbac::RBAC_PERM_COMMAND_SERVER_EXIT,         true, &HandleServerExitCommand,    "", NULL },
             { "idlerestart",  rbac::RBAC_PERM_COMMAND_SERVER_IDLERESTART,  true, NULL,                        "", serverIdleRestartCommandTable },
             { "idleshutdown", rbac::RBAC_PERM_COMMAND_SERVER_IDLESHUTDOWN, true, NULL,                        "", serverIdleShutdownCommandTable },
@@ -104,6 +106,53 @@ public:
         return true;
     }
 
+    // Show per statement and queue telemetry of the database pools
+    // .server dbstats [login|world|character|reset] [#count]
+    static bool HandleServerDBStatsCommand(ChatHandler* handler, char const* args)
+    {
+        char* nameStr = strtok((char*)args, " ");
+        char* countStr = strtok(NULL, " ");
+
+        uint32 count = 10;
+        if (nameStr && isNumeric(nameStr))
+        {
+            count = atoi(nameStr);
+            nameStr = NULL;
+        }
+        else if (countStr)
+            count = atoi(countStr);
+
+        if (!count)
+            return false;
+
+        if (!nameStr)
+        {
+            SendDatabaseStatistics(handler, "Login", LoginDatabase, count);
+            SendDatabaseStatistics(handler, "World", WorldDatabase, count);
+            SendDatabaseStatistics(handler, "Character", CharacterDatabase, count);
+            return true;
+        }
+
+        size_t length = strlen(nameStr);
+        if (strncmp(nameStr, "login", length) == 0)
+            SendDatabaseStatistics(handler, "Login", LoginDatabase, count);
+        else if (strncmp(nameStr, "world", length) == 0)
+            SendDatabaseStatistics(handler, "World", WorldDatabase, count);
+        else if (strncmp(nameStr, "character", length) == 0)
+            SendDatabaseStatistics(handler, "Character", CharacterDatabase, count);
+        else if (strncmp(nameStr, "reset", length) == 0)
+        {
+            LoginDatabase.ResetStatistics();
+            WorldDatabase.ResetStatistics();
+            CharacterDatabase.ResetStatistics();
+            handler->SendSysMessage("Database statistics reset.");
+        }
+        else
+            return false;
+
+        return true;
+    }
+
     static bool HandleServerInfoCommand(ChatHandler* handler, char const* /*args*/)
     {
         uint32 playersNum           = sWorld->GetPlayerCount();
@@ -294,6 +343,25 @@ public:
     }
 
 private:
+    template<class T>
+    static void SendDatabaseStatistics(ChatHandler* handler, char const* name, DatabaseWorkerPool<T> const& pool, uint32 count)
+    {
+        DatabaseStatistics const& statistics = pool.GetStatistics();
+        uint64 queued = statistics.GetQueuedOperations();
+
+        handler->PSendSysMessage("%s database: async queue size %u (max %u), " UI64FMTD " operations dequeued, avg wait " UI64FMTD " us, max wait " UI64FMTD " us",
+            name, statistics.GetQueueSize(), statistics.GetMaxQueueSize(), queued, queued ? statistics.GetTotalQueueTime() / queued : 0, statistics.GetMaxQueueTime());
+
+        std::vector<PreparedStatementStats> stats;
+        statistics.GetTopStatements(count, stats);
+        for (PreparedStatementStats const& stat : stats)
+        {
+            handler->PSendSysMessage("  #%u: " UI64FMTD " execs, " UI64FMTD " rows, total " UI64FMTD " ms, avg " UI64FMTD " us, max " UI64FMTD " us, queued " UI64FMTD " ms",
+                stat.Index, stat.Executions, stat.Rows, stat.TotalTime / IN_MILLISECONDS, stat.TotalTime / stat.Executions, stat.MaxTime, stat.QueueTime / IN_MILLISECONDS);
+            handler->PSendSysMessage("    %s", stat.Query->c_str());
+        }
+    }
+
     static bool ParseExitCode(char const* exitCodeStr, int32& exitCode)
     {
         exitCode = atoi(exitCodeStr);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DatabaseStatistics.h"
+#include <algorithm>
+
+DatabaseStatistics::DatabaseStatistics() : _statementCount(0), _queueSize(0), _maxQueueSize(0),
+    _queuedOperations(0), _totalQueueTime(0), _maxQueueTime(0) { }
+
+void DatabaseStatistics::Initialize(std::vector<std::string> const& queries)
+{
+    // Statements are prepared only once per pool, reconnections reuse the same indexes
+    if (_counters)
+        return;
+
+    _queries = queries;
+    _statementCount = uint32(_queries.size());
+    _counters.reset(new PreparedStatementCounters[_statementCount]);
+}
+
+void DatabaseStatistics::OnEnqueue()
+{
+    UpdateMax(_maxQueueSize, ++_queueSize);
+}
+
+void DatabaseStatistics::OnDequeue(uint32 index, uint64 queueTime)
+{
+    --_queueSize;
+    ++_queuedOperations;
+    _totalQueueTime += queueTime;
+    UpdateMax(_maxQueueTime, queueTime);
+
+    if (index < _statementCount)
+        _counters[index].QueueTime += queueTime;
+}
+
+void DatabaseStatistics::OnStatementExecuted(uint32 index, uint64 rows, uint64 executionTime)
+{
+    if (index >= _statementCount)
+        return;
+
+    PreparedStatementCounters& counters = _counters[index];
+    ++counters.Executions;
+    counters.Rows += rows;
+    counters.TotalTime += executionTime;
+    UpdateMax(counters.MaxTime, executionTime);
+}
+
+void DatabaseStatistics::GetTopStatements(uint32 count, std::vector<PreparedStatementStats>& stats) const
+{
+    stats.clear();
+    for (uint32 i = 0; i < _statementCount; ++i)
+    {
+        PreparedStatementCounters const& counters = _counters[i];
+        if (!counters.Executions)
+            continue;
+
+        PreparedStatementStats stat;
+        stat.Index = i;
+        stat.Executions = counters.Executions;
+        stat.Rows = counters.Rows;
+        stat.TotalTime = counters.TotalTime;
+        stat.MaxTime = counters.MaxTime;
+        stat.QueueTime = counters.QueueTime;
+        stat.Query = &_queries[i];
+        stats.push_back(stat);
+    }
+
+    std::sort(stats.begin(), stats.end(), [](PreparedStatementStats const& left, PreparedStatementStats const& right)
+    {
+        return left.TotalTime > right.TotalTime;
+    });
+
+    if (stats.size() > count)
+        stats.resize(count);
+}
+
+void DatabaseStatistics::Reset()
+{
+    for (uint32 i = 0; i < _statementCount; ++i)
+    {
+        PreparedStatementCounters& counters = _counters[i];
+        counters.Executions = 0;
+        counters.Rows = 0;
+        counters.TotalTime = 0;
+        counters.MaxTime = 0;
+        counters.QueueTime = 0;
+    }
+
+    _maxQueueSize = uint32(_queueSize);
+    _queuedOperations = 0;
+    _totalQueueTime = 0;
+    _maxQueueTime = 0;
+}
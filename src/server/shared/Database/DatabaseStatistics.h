@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _DATABASESTATISTICS_H
+#define _DATABASESTATISTICS_H
+
+#include "Define.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+//- Index used for operations that are not tied to a prepared statement (adhoc queries, transactions, holders, pings)
+#define STATEMENT_INDEX_NONE 0xFFFFFFFF
+
+//- Counters of a single prepared statement index, updated concurrently by all connections of a pool
+struct PreparedStatementCounters
+{
+    PreparedStatementCounters() : Executions(0), Rows(0), TotalTime(0), MaxTime(0), QueueTime(0) { }
+
+    std::atomic<uint64> Executions;
+    std::atomic<uint64> Rows;
+    std::atomic<uint64> TotalTime;      //- microseconds spent in mysql_stmt_execute and result fetching
+    std::atomic<uint64> MaxTime;        //- microseconds, slowest single execution
+    std::atomic<uint64> QueueTime;      //- microseconds spent waiting in the async queue
+};
+
+//- Plain copy of PreparedStatementCounters for reporting
+struct PreparedStatementStats
+{
+    uint32 Index;
+    uint64 Executions;
+    uint64 Rows;
+    uint64 TotalTime;
+    uint64 MaxTime;
+    uint64 QueueTime;
+    std::string const* Query;
+};
+
+//- Per DatabaseWorkerPool telemetry: per statement execution counters and async queue depth gauges
+class DatabaseStatistics
+{
+    public:
+        DatabaseStatistics();
+
+        //! Called once statements were prepared, sizes the counter storage
+        void Initialize(std::vector<std::string> const& queries);
+
+        void OnEnqueue();
+        void OnDequeue(uint32 index, uint64 queueTime);
+        void OnStatementExecuted(uint32 index, uint64 rows, uint64 executionTime);
+
+        //! Returns the statements with the highest total execution time, ordered descending
+        void GetTopStatements(uint32 count, std::vector<PreparedStatementStats>& stats) const;
+
+        uint32 GetQueueSize() const { return _queueSize; }
+        uint32 GetMaxQueueSize() const { return _maxQueueSize; }
+        uint64 GetQueuedOperations() const { return _queuedOperations; }
+        uint64 GetTotalQueueTime() const { return _totalQueueTime; }
+        uint64 GetMaxQueueTime() const { return _maxQueueTime; }
+
+        void Reset();
+
+    private:
+        template<typename T>
+        static void UpdateMax(std::atomic<T>& maxValue, T value)
+        {
+            T current = maxValue;
+            while (value > current && !maxValue.compare_exchange_weak(current, value)) { }
+        }
+
+        std::unique_ptr<PreparedStatementCounters[]> _counters;
+        std::vector<std::string> _queries;
+        uint32 _statementCount;
+
+        std::atomic<uint32> _queueSize;
+        std::atomic<uint32> _maxQueueSize;
+        std::atomic<uint64> _queuedOperations;
+        std::atomic<uint64> _totalQueueTime;
+        std::atomic<uint64> _maxQueueTime;
+
+        DatabaseStatistics(DatabaseStatistics const& right) = delete;
+        DatabaseStatistics& operator=(DatabaseStatistics const& right) = delete;
+};
+
+#endif
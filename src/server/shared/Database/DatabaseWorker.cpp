@@ -19,6 +19,7 @@
 #include "DatabaseWorker.h"
 #include "SQLOperation.h"
 #include "ProducerConsumerQueue.h"
+#include "Timer.h"
 
 DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection)
 {
@@ -51,6 +52,9 @@ void DatabaseWorker::WorkerThread()
         if (_cancelationToken || !operation)
             return;
 
+        if (DatabaseStatistics* statistics = _connection->GetStatistics())
+            statistics->OnDequeue(operation->GetStatementIndex(), GetUSTimeDiffToNow(operation->m_enqueueTime));
+
         operation->SetConnection(_connection);
         operation->call();
 
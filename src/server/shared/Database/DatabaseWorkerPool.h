@@ -29,6 +29,8 @@
 #include "QueryHolder.h"
 #include "AdhocStatement.h"
 #include "StringFormat.h"
+#include "DatabaseStatistics.h"
+#include "Timer.h"
 
 #include <mysqld_error.h>
 #include <memory>
@@ -146,6 +148,14 @@ class DatabaseWorkerPool
                         t->Unlock();
                 }
 
+            //! Statement indexes are the same on every connection, use the first synchronous one for the query strings
+            T* t = _connections[IDX_SYNCH][0];
+            std::vector<std::string> queries(t->m_stmts.size());
+            for (PreparedStatementMap::const_iterator itr = t->m_queries.begin(); itr != t->m_queries.end(); ++itr)
+                if (itr->first < queries.size())
+                    queries[itr->first] = itr->second.first;
+
+            _statistics.Initialize(queries);
             return true;
         }
 
@@ -327,6 +337,14 @@ class DatabaseWorkerPool
             return result;
         }
 
+        //! Enqueues a query in prepared format. As soon as the query is executed the result is pushed to the given completion queue,
+        //! the callback is invoked when the owner of that queue processes it. No polling is needed.
+        //! Statement must be prepared with CONNECTION_ASYNC flag.
+        void AsyncQuery(PreparedStatement* stmt, SQLQueryCompletionQueuePtr const& queue, SQLQueryResultCompletion<PreparedQueryResult>::Callback&& callback)
+        {
+            Enqueue(new PreparedStatementTask(stmt, queue, std::move(callback)));
+        }
+
         //! Enqueues a vector of SQL operations (can be both adhoc and prepared) that will set the value of the QueryResultHolderFuture
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
@@ -340,6 +358,24 @@ class DatabaseWorkerPool
             return result;
         }
 
+        //! Enqueues a vector of SQL operations (can be both adhoc and prepared). Once all of them are executed the holder is pushed
+        //! to the given completion queue and handed to the callback, which takes ownership of it.
+        //! The operations are spread over all async connections and run in parallel, they must not depend on each other.
+        //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
+        void DelayQueryHolder(SQLQueryHolder* holder, SQLQueryCompletionQueuePtr const& queue, SQLQueryHolderCompletion::Callback&& callback)
+        {
+            uint32 slices = std::min<uint32>(_connectionCount[IDX_ASYNC], uint32(holder->GetSize()));
+            if (slices <= 1)
+            {
+                Enqueue(new SQLQueryHolderTask(holder, queue, std::move(callback)));
+                return;
+            }
+
+            std::shared_ptr<SQLQueryHolderFanOut> fanOut = std::make_shared<SQLQueryHolderFanOut>(holder, slices, queue, std::move(callback));
+            for (uint32 i = 0; i < slices; ++i)
+                Enqueue(new SQLQueryHolderSliceTask(fanOut, i));
+        }
+
         /**
             Transaction context methods.
         */
@@ -448,6 +484,17 @@ class DatabaseWorkerPool
             delete[] buf;
         }
 
+        //! Per statement execution counters and async queue gauges of this pool.
+        DatabaseStatistics const& GetStatistics() const
+        {
+            return _statistics;
+        }
+
+        void ResetStatistics()
+        {
+            _statistics.Reset();
+        }
+
         //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
         void KeepAlive()
         {
@@ -485,6 +532,7 @@ class DatabaseWorkerPool
                     ASSERT(false);
 
                 _connections[type][i] = t;
+                t->m_statistics = &_statistics;
                 ++_connectionCount[type];
 
                 uint32 error = t->Open();
@@ -525,6 +573,8 @@ class DatabaseWorkerPool
 
         void Enqueue(SQLOperation* op)
         {
+            op->m_enqueueTime = getUSTime();
+            _statistics.OnEnqueue();
             _queue->Push(op);
         }
 
@@ -559,6 +609,7 @@ class DatabaseWorkerPool
         uint32 _connectionCount[IDX_SIZE];
         std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
         uint8 _async_threads, _synch_threads;
+        DatabaseStatistics _statistics;
 };
 
 #endif
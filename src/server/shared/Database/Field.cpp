@@ -23,6 +23,7 @@ Field::Field()
     data.type = MYSQL_TYPE_NULL;
     data.length = 0;
     data.raw = false;
+    data.owner = false;
 }
 
 Field::~Field()
@@ -41,6 +42,7 @@ void Field::SetByteValue(const void* newValue, const size_t newSize, enum_field_
         data.value = new char[newSize];
         memcpy(data.value, newValue, newSize);
         data.length = length;
+        data.owner = true;
     }
     data.type = newType;
     data.raw = true;
@@ -58,8 +60,21 @@ void Field::SetStructuredValue(char* newValue, enum_field_types newType)
         data.value = new char [size+1];
         strcpy((char*)data.value, newValue);
         data.length = size;
+        data.owner = true;
     }
 
     data.type = newType;
     data.raw = false;
 }
+
+void Field::SetArenaValue(void* newValue, enum_field_types newType, uint32 length)
+{
+    if (data.value)
+        CleanUp();
+
+    // Memory is owned by the PreparedResultSet holding this field, it is not copied nor freed here
+    data.value = newValue;
+    data.length = length;
+    data.type = newType;
+    data.raw = true;
+}
@@ -271,6 +271,7 @@ class Field
             void* value;            // Actual data in memory
             enum_field_types type;  // Field type
             bool raw;               // Raw bytes? (Prepared statement or ad hoc)
+            bool owner;             // value was allocated by this field (false for PreparedResultSet arena memory)
          } data;
         #if defined(__GNUC__)
         #pragma pack()
@@ -280,11 +281,14 @@ class Field
 
         void SetByteValue(void const* newValue, size_t const newSize, enum_field_types newType, uint32 length);
         void SetStructuredValue(char* newValue, enum_field_types newType);
+        void SetArenaValue(void* newValue, enum_field_types newType, uint32 length);
 
         void CleanUp()
         {
-            delete[] ((char*)data.value);
+            if (data.owner)
+                delete[] ((char*)data.value);
             data.value = NULL;
+            data.owner = false;
         }
 
         static size_t SizeForType(MYSQL_FIELD* field)
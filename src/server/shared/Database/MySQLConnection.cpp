@@ -40,7 +40,8 @@ m_queue(NULL),
 m_worker(NULL),
 m_Mysql(NULL),
 m_connectionInfo(connInfo),
-m_connectionFlags(CONNECTION_SYNCH) { }
+m_connectionFlags(CONNECTION_SYNCH),
+m_statistics(NULL) { }
 
 MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
@@ -48,7 +49,8 @@ m_prepareError(false),
 m_queue(queue),
 m_Mysql(NULL),
 m_connectionInfo(connInfo),
-m_connectionFlags(CONNECTION_ASYNC)
+m_connectionFlags(CONNECTION_ASYNC),
+m_statistics(NULL)
 {
     m_worker = new DatabaseWorker(m_queue, this);
 }
@@ -196,6 +198,7 @@ bool MySQLConnection::Execute(PreparedStatement* stmt)
         MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
         uint32 _s = getMSTime();
+        uint64 startTime = getUSTime();
 
         if (mysql_stmt_bind_param(msql_STMT, msql_BIND))
         {
@@ -223,6 +226,9 @@ bool MySQLConnection::Execute(PreparedStatement* stmt)
 
         TC_LOG_DEBUG("sql.sql", "[%u ms] SQL(p): %s", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString(m_queries[index].first).c_str());
 
+        if (m_statistics)
+            m_statistics->OnStatementExecuted(index, mysql_stmt_affected_rows(msql_STMT), GetUSTimeDiffToNow(startTime));
+
         m_mStmt->ClearParameters();
         return true;
     }
@@ -466,6 +472,7 @@ PreparedResultSet* MySQLConnection::Query(PreparedStatement* stmt)
     MYSQL_RES *result = NULL;
     uint64 rowCount = 0;
     uint32 fieldCount = 0;
+    uint64 startTime = getUSTime();
 
     if (!_Query(stmt, &result, &rowCount, &fieldCount))
         return NULL;
@@ -474,7 +481,14 @@ PreparedResultSet* MySQLConnection::Query(PreparedStatement* stmt)
     {
         mysql_next_result(m_Mysql);
     }
-    return new PreparedResultSet(stmt->m_stmt->GetSTMT(), result, rowCount, fieldCount);
+
+    PreparedResultSet* resultSet = new PreparedResultSet(stmt->m_stmt->GetSTMT(), result, rowCount, fieldCount);
+
+    // Fetching rows is accounted to the statement as well, for big resultsets it dominates the execution time
+    if (m_statistics)
+        m_statistics->OnStatementExecuted(stmt->m_index, resultSet->GetRowCount(), GetUSTimeDiffToNow(startTime));
+
+    return resultSet;
 }
 
 bool MySQLConnection::_HandleMySQLErrno(uint32 errNo)
@@ -95,6 +95,8 @@ class MySQLConnection
 
         uint32 GetLastError() { return mysql_errno(m_Mysql); }
 
+        DatabaseStatistics* GetStatistics() const { return m_statistics; }
+
     protected:
         bool LockIfReady()
         {
@@ -130,6 +132,7 @@ class MySQLConnection
         MYSQL *               m_Mysql;                      //! MySQL Handle.
         MySQLConnectionInfo&  m_connectionInfo;             //! Connection info (used for logging)
         ConnectionFlags       m_connectionFlags;            //! Connection flags (for preparing relevant statements)
+        DatabaseStatistics*   m_statistics;                 //! Telemetry of the owning pool, set by DatabaseWorkerPool.
         std::mutex            m_Mutex;
 
         MySQLConnection(MySQLConnection const& right) = delete;
@@ -446,18 +446,25 @@ std::string MySQLPreparedStatement::getQueryString(std::string const& sqlPattern
 
 //- Execution
 PreparedStatementTask::PreparedStatementTask(PreparedStatement* stmt, bool async) :
-m_stmt(stmt), m_result(nullptr)
+m_stmt(stmt), m_result(nullptr), m_completion(nullptr)
 {
     m_has_result = async; // If it's async, then there's a result
     if (async)
         m_result = new PreparedQueryResultPromise();
 }
 
+PreparedStatementTask::PreparedStatementTask(PreparedStatement* stmt, SQLQueryCompletionQueuePtr const& queue, SQLQueryResultCompletion<PreparedQueryResult>::Callback&& callback) :
+m_stmt(stmt), m_has_result(true), m_result(nullptr), m_completionQueue(queue),
+m_completion(new SQLQueryResultCompletion<PreparedQueryResult>(std::move(callback))) { }
+
 PreparedStatementTask::~PreparedStatementTask()
 {
     delete m_stmt;
     if (m_has_result && m_result != nullptr)
         delete m_result;
+
+    // Only set if the task was never executed
+    delete m_completion;
 }
 
 bool PreparedStatementTask::Execute()
@@ -468,12 +475,24 @@ bool PreparedStatementTask::Execute()
         if (!result || !result->GetRowCount())
         {
             delete result;
-            m_result->set_value(PreparedQueryResult(NULL));
+            SetResult(PreparedQueryResult(NULL));
             return false;
         }
-        m_result->set_value(PreparedQueryResult(result));
+        SetResult(PreparedQueryResult(result));
         return true;
     }
 
     return m_conn->Execute(m_stmt);
 }
+
+void PreparedStatementTask::SetResult(PreparedQueryResult result)
+{
+    if (m_completion)
+    {
+        m_completion->SetResult(std::move(result));
+        m_completionQueue->Push(m_completion);
+        m_completion = nullptr;
+    }
+    else
+        m_result->set_value(result);
+}
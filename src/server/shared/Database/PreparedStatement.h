@@ -20,6 +20,7 @@
 
 #include <future>
 #include "SQLOperation.h"
+#include "QueryCompletionQueue.h"
 
 #ifdef __APPLE__
 #undef TYPE_BOOL
@@ -161,14 +162,20 @@ class PreparedStatementTask : public SQLOperation
 {
     public:
         PreparedStatementTask(PreparedStatement* stmt, bool async = false);
+        PreparedStatementTask(PreparedStatement* stmt, SQLQueryCompletionQueuePtr const& queue, SQLQueryResultCompletion<PreparedQueryResult>::Callback&& callback);
         ~PreparedStatementTask();
 
         bool Execute() override;
+        uint32 GetStatementIndex() const override { return m_stmt->m_index; }
         PreparedQueryResultFuture GetFuture() { return m_result->get_future(); }
 
     protected:
+        void SetResult(PreparedQueryResult result);
+
         PreparedStatement* m_stmt;
         bool m_has_result;
         PreparedQueryResultPromise* m_result;
+        SQLQueryCompletionQueuePtr m_completionQueue;
+        SQLQueryResultCompletion<PreparedQueryResult>* m_completion;
 };
 #endif
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _QUERYCOMPLETIONQUEUE_H
+#define _QUERYCOMPLETIONQUEUE_H
+
+#include "QueryResult.h"
+#include "MPSCQueue.h"
+#include <functional>
+#include <memory>
+
+class SQLQueryHolder;
+
+//- A finished asynchronous query together with the callback that consumes it
+class SQLQueryCompletion
+{
+    public:
+        virtual ~SQLQueryCompletion() { }
+
+        virtual void Invoke() = 0;
+};
+
+template<typename Result>
+class SQLQueryResultCompletion : public SQLQueryCompletion
+{
+    public:
+        typedef std::function<void(Result)> Callback;
+
+        explicit SQLQueryResultCompletion(Callback&& callback) : _callback(std::move(callback)) { }
+
+        void SetResult(Result result) { _result = std::move(result); }
+        void Invoke() override { _callback(std::move(_result)); }
+
+    private:
+        Callback _callback;
+        Result _result;
+};
+
+//- The holder is owned by the callback once invoked, by the completion before that
+class SQLQueryHolderCompletion : public SQLQueryCompletion
+{
+    public:
+        typedef std::function<void(SQLQueryHolder*)> Callback;
+
+        explicit SQLQueryHolderCompletion(Callback&& callback) : _callback(std::move(callback)), _holder(NULL) { }
+        ~SQLQueryHolderCompletion();
+
+        void SetResult(SQLQueryHolder* holder) { _holder = holder; }
+        void Invoke() override
+        {
+            SQLQueryHolder* holder = _holder;
+            _holder = NULL;
+            _callback(holder);
+        }
+
+    private:
+        Callback _callback;
+        SQLQueryHolder* _holder;
+};
+
+//- Per consumer queue of finished asynchronous queries.
+//- Database workers push completions as soon as a result is available, the consumer (world, session)
+//- drains it once per update instead of polling a future for every pending query.
+class SQLQueryCompletionQueue
+{
+    public:
+        void Push(SQLQueryCompletion* completion) { _queue.Enqueue(completion); }
+
+        //! Invokes the callbacks of all finished queries, must only be called from the owning thread
+        void ProcessReadyCallbacks()
+        {
+            SQLQueryCompletion* completion;
+            while (_queue.Dequeue(completion))
+            {
+                completion->Invoke();
+                delete completion;
+            }
+        }
+
+    private:
+        MPSCQueue<SQLQueryCompletion> _queue;
+};
+
+//- Shared between the consumer and in-flight tasks, so a consumer may go away while its queries are still running
+typedef std::shared_ptr<SQLQueryCompletionQueue> SQLQueryCompletionQueuePtr;
+
+#endif
@@ -143,10 +143,41 @@ void SQLQueryHolder::SetSize(size_t size)
     m_queries.resize(size);
 }
 
+void SQLQueryHolder::ExecuteQuery(size_t index, MySQLConnection* conn)
+{
+    SQLElementData* data = &m_queries[index].first;
+    switch (data->type)
+    {
+        case SQL_ELEMENT_RAW:
+        {
+            char const* sql = data->element.query;
+            if (sql)
+                SetResult(index, conn->Query(sql));
+            break;
+        }
+        case SQL_ELEMENT_PREPARED:
+        {
+            PreparedStatement* stmt = data->element.stmt;
+            if (stmt)
+                SetPreparedResult(index, conn->Query(stmt));
+            break;
+        }
+    }
+}
+
 SQLQueryHolderTask::~SQLQueryHolderTask()
 {
     if (!m_executed)
         delete m_holder;
+
+    // Only set if the task was never executed
+    delete m_completion;
+}
+
+SQLQueryHolderCompletion::~SQLQueryHolderCompletion()
+{
+    // Consumer went away before the callback could be invoked
+    delete _holder;
 }
 
 bool SQLQueryHolderTask::Execute()
@@ -156,34 +187,50 @@ bool SQLQueryHolderTask::Execute()
     if (!m_holder)
         return false;
 
-    /// we can do this, we are friends
-    std::vector<SQLQueryHolder::SQLResultPair> &queries = m_holder->m_queries;
+    /// execute all queries in the holder and pass the results
+    for (size_t i = 0; i < m_holder->m_queries.size(); i++)
+        m_holder->ExecuteQuery(i, m_conn);
 
-    for (size_t i = 0; i < queries.size(); i++)
+    if (m_completion)
     {
-        /// execute all queries in the holder and pass the results
-        if (SQLElementData* data = &queries[i].first)
-        {
-            switch (data->type)
-            {
-                case SQL_ELEMENT_RAW:
-                {
-                    char const* sql = data->element.query;
-                    if (sql)
-                        m_holder->SetResult(i, m_conn->Query(sql));
-                    break;
-                }
-                case SQL_ELEMENT_PREPARED:
-                {
-                    PreparedStatement* stmt = data->element.stmt;
-                    if (stmt)
-                        m_holder->SetPreparedResult(i, m_conn->Query(stmt));
-                    break;
-                }
-            }
-        }
+        m_completion->SetResult(m_holder);
+        m_completionQueue->Push(m_completion);
+        m_completion = NULL;
     }
+    else
+        m_result.set_value(m_holder);
+    return true;
+}
+
+SQLQueryHolderFanOut::~SQLQueryHolderFanOut()
+{
+    // Not all slices were executed (pool shut down), nobody will ever receive the holder
+    if (m_completion)
+    {
+        delete m_completion;
+        delete m_holder;
+    }
+}
+
+void SQLQueryHolderFanOut::OnSliceExecuted()
+{
+    // Slices only touch their own elements of the holder, the last one sees all results through the counter
+    if (m_pendingSlices.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    m_completion->SetResult(m_holder);
+    m_completionQueue->Push(m_completion);
+    m_completion = NULL;
+}
+
+bool SQLQueryHolderSliceTask::Execute()
+{
+    SQLQueryHolder* holder = m_fanOut->GetHolder();
+    uint32 sliceCount = m_fanOut->GetSliceCount();
+
+    for (size_t i = m_slice; i < holder->m_queries.size(); i += sliceCount)
+        holder->ExecuteQuery(i, m_conn);
 
-    m_result.set_value(m_holder);
+    m_fanOut->OnSliceExecuted();
     return true;
 }
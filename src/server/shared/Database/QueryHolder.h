@@ -19,13 +19,18 @@
 #define _QUERYHOLDER_H
 
 #include <future>
+#include <atomic>
+#include "QueryCompletionQueue.h"
 
 class SQLQueryHolder
 {
     friend class SQLQueryHolderTask;
+    friend class SQLQueryHolderSliceTask;
     private:
         typedef std::pair<SQLElementData, SQLResultSetUnion> SQLResultPair;
         std::vector<SQLResultPair> m_queries;
+
+        void ExecuteQuery(size_t index, MySQLConnection* conn);
     public:
         SQLQueryHolder() { }
         ~SQLQueryHolder();
@@ -34,6 +39,7 @@ class SQLQueryHolder
         bool SetPQuery(size_t index, const char* sql, Args const&... args) { return SetQuery(index, Trinity::StringFormat(sql, args...).c_str()); }
         bool SetPreparedQuery(size_t index, PreparedStatement* stmt);
         void SetSize(size_t size);
+        size_t GetSize() const { return m_queries.size(); }
         QueryResult GetResult(size_t index);
         PreparedQueryResult GetPreparedResult(size_t index);
         void SetResult(size_t index, ResultSet* result);
@@ -50,9 +56,15 @@ class SQLQueryHolderTask : public SQLOperation
         QueryResultHolderPromise m_result;
         bool m_executed;
 
+        SQLQueryCompletionQueuePtr m_completionQueue;
+        SQLQueryHolderCompletion* m_completion;
+
     public:
         SQLQueryHolderTask(SQLQueryHolder* holder)
-            : m_holder(holder), m_executed(false) { }
+            : m_holder(holder), m_executed(false), m_completion(NULL) { }
+
+        SQLQueryHolderTask(SQLQueryHolder* holder, SQLQueryCompletionQueuePtr const& queue, SQLQueryHolderCompletion::Callback&& callback)
+            : m_holder(holder), m_executed(false), m_completionQueue(queue), m_completion(new SQLQueryHolderCompletion(std::move(callback))) { }
 
         ~SQLQueryHolderTask();
 
@@ -60,4 +72,43 @@ class SQLQueryHolderTask : public SQLOperation
         QueryResultHolderFuture GetFuture() { return m_result.get_future(); }
 };
 
+//- State shared by the tasks a holder is split into, the last one to finish hands the holder to the completion queue
+class SQLQueryHolderFanOut
+{
+    public:
+        SQLQueryHolderFanOut(SQLQueryHolder* holder, uint32 sliceCount, SQLQueryCompletionQueuePtr const& queue, SQLQueryHolderCompletion::Callback&& callback)
+            : m_holder(holder), m_sliceCount(sliceCount), m_pendingSlices(sliceCount), m_completionQueue(queue),
+            m_completion(new SQLQueryHolderCompletion(std::move(callback))) { }
+
+        ~SQLQueryHolderFanOut();
+
+        SQLQueryHolder* GetHolder() const { return m_holder; }
+        uint32 GetSliceCount() const { return m_sliceCount; }
+        void OnSliceExecuted();
+
+    private:
+        SQLQueryHolder* m_holder;
+        uint32 m_sliceCount;
+        std::atomic<uint32> m_pendingSlices;
+        SQLQueryCompletionQueuePtr m_completionQueue;
+        SQLQueryHolderCompletion* m_completion;
+
+        SQLQueryHolderFanOut(SQLQueryHolderFanOut const& right) = delete;
+        SQLQueryHolderFanOut& operator=(SQLQueryHolderFanOut const& right) = delete;
+};
+
+//- Executes every GetSliceCount()th query of a holder, the slices of one holder run in parallel on different async connections
+class SQLQueryHolderSliceTask : public SQLOperation
+{
+    private:
+        std::shared_ptr<SQLQueryHolderFanOut> m_fanOut;
+        uint32 m_slice;
+
+    public:
+        SQLQueryHolderSliceTask(std::shared_ptr<SQLQueryHolderFanOut> const& fanOut, uint32 slice)
+            : m_fanOut(fanOut), m_slice(slice) { }
+
+        bool Execute() override;
+};
+
 #endif
@@ -29,7 +29,37 @@ _fields(fields)
     ASSERT(_currentRow);
 }
 
+namespace
+{
+    //- Alignment of fixed size values in the bind buffer and the row arena, enough for any numeric type and MYSQL_TIME
+    size_t const RESULT_VALUE_ALIGNMENT = 8;
+    size_t const NULL_VALUE_OFFSET = ~size_t(0);
+
+    inline size_t AlignValueOffset(size_t offset)
+    {
+        return (offset + RESULT_VALUE_ALIGNMENT - 1) & ~(RESULT_VALUE_ALIGNMENT - 1);
+    }
+
+    //- Values that are read as (not necessarily null terminated by the server) strings
+    inline bool IsTextType(enum_field_types type)
+    {
+        switch (type)
+        {
+            case MYSQL_TYPE_TINY_BLOB:
+            case MYSQL_TYPE_MEDIUM_BLOB:
+            case MYSQL_TYPE_LONG_BLOB:
+            case MYSQL_TYPE_BLOB:
+            case MYSQL_TYPE_STRING:
+            case MYSQL_TYPE_VAR_STRING:
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
 PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES *result, uint64 rowCount, uint32 fieldCount) :
+m_rows(NULL),
 m_rowCount(rowCount),
 m_rowPosition(0),
 m_fieldCount(fieldCount),
@@ -37,7 +67,8 @@ m_rBind(NULL),
 m_stmt(stmt),
 m_res(result),
 m_isNull(NULL),
-m_length(NULL)
+m_length(NULL),
+m_bindBuffer(NULL)
 {
     if (!m_res)
         return;
@@ -67,6 +98,8 @@ m_length(NULL)
     }
 
     //- This is where we prepare the buffer based on metadata
+    //- All columns share one bind buffer, each column starting at an aligned offset
+    size_t bindBufferSize = 0;
     uint32 i = 0;
     MYSQL_FIELD* field = mysql_fetch_field(m_res);
     while (field)
@@ -74,18 +107,25 @@ m_length(NULL)
         size_t size = Field::SizeForType(field);
 
         m_rBind[i].buffer_type = field->type;
-        m_rBind[i].buffer = malloc(size);
-        memset(m_rBind[i].buffer, 0, size);
         m_rBind[i].buffer_length = size;
         m_rBind[i].length = &m_length[i];
         m_rBind[i].is_null = &m_isNull[i];
         m_rBind[i].error = NULL;
         m_rBind[i].is_unsigned = field->flags & UNSIGNED_FLAG;
 
+        bindBufferSize += AlignValueOffset(size);
         ++i;
         field = mysql_fetch_field(m_res);
     }
 
+    m_bindBuffer = new char[bindBufferSize];
+    memset(m_bindBuffer, 0, bindBufferSize);
+    for (size_t fIndex = 0, offset = 0; fIndex < m_fieldCount; ++fIndex)
+    {
+        m_rBind[fIndex].buffer = m_bindBuffer + offset;
+        offset += AlignValueOffset(m_rBind[fIndex].buffer_length);
+    }
+
     //- This is where we bind the bind the buffer to the statement
     if (mysql_stmt_bind_result(m_stmt, m_rBind))
     {
@@ -93,47 +133,46 @@ m_length(NULL)
         delete[] m_rBind;
         delete[] m_isNull;
         delete[] m_length;
+        delete[] m_bindBuffer;
         return;
     }
 
     m_rowCount = mysql_stmt_num_rows(m_stmt);
 
-    m_rows.resize(uint32(m_rowCount));
+    //- Fields of all rows are allocated at once and their values copied into one arena. The arena may still move
+    //- while it grows, so values are indexed by offset first and fields only point into it once every row is fetched.
+    //- The bind buffer size is an upper bound of a row (strings use their column max length), so usually it never grows.
+    size_t const fieldTotal = size_t(m_rowCount) * m_fieldCount;
+    std::vector<size_t> valueOffsets(fieldTotal, NULL_VALUE_OFFSET);
+    m_rows = new Field[fieldTotal];
+    m_rowData.reserve(size_t(m_rowCount) * bindBufferSize);
+
     while (_NextRow())
     {
-        m_rows[uint32(m_rowPosition)] = new Field[m_fieldCount];
-        for (uint64 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
+        size_t const rowIndex = size_t(m_rowPosition) * m_fieldCount;
+        for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
         {
-            if (!*m_rBind[fIndex].is_null)
-                m_rows[uint32(m_rowPosition)][fIndex].SetByteValue(m_rBind[fIndex].buffer,
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length);
-            else
-                switch (m_rBind[fIndex].buffer_type)
-                {
-                    case MYSQL_TYPE_TINY_BLOB:
-                    case MYSQL_TYPE_MEDIUM_BLOB:
-                    case MYSQL_TYPE_LONG_BLOB:
-                    case MYSQL_TYPE_BLOB:
-                    case MYSQL_TYPE_STRING:
-                    case MYSQL_TYPE_VAR_STRING:
-                    m_rows[uint32(m_rowPosition)][fIndex].SetByteValue("",
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length);
-                    break;
-                    default:
-                    m_rows[uint32(m_rowPosition)][fIndex].SetByteValue(nullptr,
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length);
-                }
+            enum_field_types type = m_rBind[fIndex].buffer_type;
+            uint32 length = 0;
+
+            //- NULL strings are read as empty strings, other NULL values have no data
+            if (!*m_rBind[fIndex].is_null || IsTextType(type))
+                valueOffsets[rowIndex + fIndex] = StoreValue(fIndex, length);
+
+            m_rows[rowIndex + fIndex].SetArenaValue(NULL, type, length);
         }
         m_rowPosition++;
     }
     m_rowPosition = 0;
 
+    //- Column max lengths are often far from the actual values, give back what was not used
+    if (m_rowData.capacity() > m_rowData.size() * 2)
+        m_rowData.shrink_to_fit();
+
+    for (size_t fIndex = 0; fIndex < fieldTotal; ++fIndex)
+        if (valueOffsets[fIndex] != NULL_VALUE_OFFSET)
+            m_rows[fIndex].data.value = &m_rowData[valueOffsets[fIndex]];
+
     /// All data is buffered, let go of mysql c api structures
     CleanUp();
 }
@@ -145,8 +184,7 @@ ResultSet::~ResultSet()
 
 PreparedResultSet::~PreparedResultSet()
 {
-    for (uint32 i = 0; i < uint32(m_rowCount); ++i)
-        delete[] m_rows[i];
+    delete[] m_rows;
 }
 
 bool ResultSet::NextRow()
@@ -190,6 +228,33 @@ bool PreparedResultSet::_NextRow()
     return retval == 0 || retval == MYSQL_DATA_TRUNCATED;
 }
 
+size_t PreparedResultSet::StoreValue(uint32 index, uint32& length)
+{
+    /// Appends the value currently fetched into the bind buffer of a column to the row arena
+    /// and returns its offset there
+    MYSQL_BIND const& bind = m_rBind[index];
+    size_t offset;
+
+    if (IsTextType(bind.buffer_type))
+    {
+        /// Only the used part is kept, terminated for GetCString()
+        length = *bind.is_null ? 0 : uint32(std::min<size_t>(*bind.length, bind.buffer_length));
+        offset = m_rowData.size();
+        m_rowData.resize(offset + length + 1);
+        memcpy(&m_rowData[offset], bind.buffer, length);
+        m_rowData[offset + length] = '\0';
+    }
+    else
+    {
+        length = uint32(*bind.length);
+        offset = AlignValueOffset(m_rowData.size());
+        m_rowData.resize(offset + bind.buffer_length);
+        memcpy(&m_rowData[offset], bind.buffer, bind.buffer_length);
+    }
+
+    return offset;
+}
+
 void ResultSet::CleanUp()
 {
     if (_currentRow)
@@ -219,6 +284,6 @@ void PreparedResultSet::CleanUp()
 
 void PreparedResultSet::FreeBindBuffer()
 {
-    for (uint32 i = 0; i < m_fieldCount; ++i)
-        free (m_rBind[i].buffer);
+    delete[] m_bindBuffer;
+    m_bindBuffer = NULL;
 }
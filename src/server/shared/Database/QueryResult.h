@@ -78,22 +78,26 @@ class PreparedResultSet
         Field* Fetch() const
         {
             ASSERT(m_rowPosition < m_rowCount);
-            return m_rows[uint32(m_rowPosition)];
+            return &m_rows[size_t(m_rowPosition) * m_fieldCount];
         }
 
         const Field & operator [] (uint32 index) const
         {
             ASSERT(m_rowPosition < m_rowCount);
             ASSERT(index < m_fieldCount);
-            return m_rows[uint32(m_rowPosition)][index];
+            return m_rows[size_t(m_rowPosition) * m_fieldCount + index];
         }
 
     protected:
-        std::vector<Field*> m_rows;
+        //- All rows, m_fieldCount consecutive fields per row
+        Field* m_rows;
         uint64 m_rowCount;
         uint64 m_rowPosition;
         uint32 m_fieldCount;
 
+        //- Values of all fields, m_rows point into this block
+        std::vector<char> m_rowData;
+
     private:
         MYSQL_BIND* m_rBind;
         MYSQL_STMT* m_stmt;
@@ -101,10 +105,12 @@ class PreparedResultSet
 
         my_bool* m_isNull;
         unsigned long* m_length;
+        char* m_bindBuffer;
 
         void FreeBindBuffer();
         void CleanUp();
         bool _NextRow();
+        size_t StoreValue(uint32 index, uint32& length);
 
         PreparedResultSet(PreparedResultSet const& right) = delete;
         PreparedResultSet& operator=(PreparedResultSet const& right) = delete;
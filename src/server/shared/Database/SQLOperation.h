@@ -19,6 +19,7 @@
 #define _SQLOPERATION_H
 
 #include "QueryResult.h"
+#include "DatabaseStatistics.h"
 
 //- Forward declare (don't include header to prevent circular includes)
 class PreparedStatement;
@@ -56,7 +57,7 @@ class MySQLConnection;
 class SQLOperation
 {
     public:
-        SQLOperation(): m_conn(NULL) { }
+        SQLOperation(): m_conn(NULL), m_enqueueTime(0) { }
         virtual ~SQLOperation() { }
 
         virtual int call()
@@ -67,7 +68,11 @@ class SQLOperation
         virtual bool Execute() = 0;
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+        //- Prepared statement index this operation is accounted to in DatabaseStatistics
+        virtual uint32 GetStatementIndex() const { return STATEMENT_INDEX_NONE; }
+
         MySQLConnection* m_conn;
+        uint64 m_enqueueTime;                               //- getUSTime() when pushed to the async queue
 
     private:
         SQLOperation(SQLOperation const& right) = delete;
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _FLATLIST_H
+#define _FLATLIST_H
+
+#include "Define.h"
+#include "Errors.h"
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+/*
+ * Ordered list of small values in one contiguous array, with a part of the
+ * std::list interface.
+ *
+ * Iterators are positions, not element addresses: they stay usable when
+ * elements are added or removed while iterating. Appended elements are still
+ * reached by a running loop, removing an element at or before the position
+ * moves the following elements down by one. An iterator past the end after
+ * removals compares equal to end().
+ *
+ * Unlike std::list, a loop that advances before removing the current element
+ * skips the next one, lists that are removed from while iterated must stay
+ * std::list.
+ */
+template<class T>
+class FlatList
+{
+    typedef std::vector<T> Storage;
+
+    public:
+        template<class Value, class List>
+        class Iterator
+        {
+            friend class FlatList;
+            template<class, class> friend class Iterator;
+
+            public:
+                typedef std::bidirectional_iterator_tag iterator_category;
+                typedef T value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef Value* pointer;
+                typedef Value& reference;
+
+                Iterator() : _list(NULL), _index(0) { }
+                Iterator(List* list, size_t index) : _list(list), _index(index) { }
+
+                // iterator -> const_iterator
+                template<class OtherValue, class OtherList>
+                Iterator(Iterator<OtherValue, OtherList> const& right) : _list(right._list), _index(right._index) { }
+
+                reference operator*() const { ASSERT(_index < _list->_elements.size()); return _list->_elements[_index]; }
+                pointer operator->() const { return &**this; }
+
+                Iterator& operator++() { ++_index; return *this; }
+                Iterator operator++(int) { Iterator tmp = *this; ++_index; return tmp; }
+                Iterator& operator--() { _index = Position() - 1; return *this; }
+                Iterator operator--(int) { Iterator tmp = *this; --*this; return tmp; }
+
+                template<class OtherValue, class OtherList>
+                bool operator==(Iterator<OtherValue, OtherList> const& right) const { return Position() == right.Position(); }
+                template<class OtherValue, class OtherList>
+                bool operator!=(Iterator<OtherValue, OtherList> const& right) const { return Position() != right.Position(); }
+
+            private:
+                size_t Position() const { return _list ? std::min(_index, _list->_elements.size()) : _index; }
+
+                List* _list;
+                size_t _index;
+        };
+
+        typedef T value_type;
+        typedef T& reference;
+        typedef T const& const_reference;
+        typedef size_t size_type;
+        typedef Iterator<T, FlatList> iterator;
+        typedef Iterator<T const, FlatList const> const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, _elements.size()); }
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, _elements.size()); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+        bool empty() const { return _elements.empty(); }
+        size_type size() const { return _elements.size(); }
+
+        reference front() { return _elements.front(); }
+        const_reference front() const { return _elements.front(); }
+        reference back() { return _elements.back(); }
+        const_reference back() const { return _elements.back(); }
+
+        void push_back(T const& value) { _elements.push_back(value); }
+        void clear() { _elements.clear(); }
+
+        /// Removes all elements equal to value, keeping the order of the others
+        void remove(T const& value) { _elements.erase(std::remove(_elements.begin(), _elements.end(), value), _elements.end()); }
+
+        /// Stable like std::list::sort
+        template<class Predicate>
+        void sort(Predicate pred) { std::stable_sort(_elements.begin(), _elements.end(), pred); }
+
+    private:
+        Storage _elements;
+};
+
+#endif
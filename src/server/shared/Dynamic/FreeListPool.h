@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _FREELISTPOOL_H
+#define _FREELISTPOOL_H
+
+#include "Define.h"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <boost/thread/tss.hpp>
+
+struct FreeListPoolStats
+{
+    uint64 HeapAllocations;                                 // blocks taken from the heap
+    uint64 Reuses;                                          // blocks taken from a free list
+};
+
+/*
+ * Keeps the memory of destroyed objects of type T on a per thread free list, the next object
+ * created on that thread gets it back instead of a new heap block. Meant to be used from the
+ * operator new/delete of classes created and destroyed at a high rate, constructors and
+ * destructors run as usual.
+ *
+ * A block freed on another thread than the one it was allocated on joins the list of the
+ * freeing thread. At most MaxFreeBlocks blocks are kept per thread, the rest goes to the heap.
+ */
+template<class T, uint32 MaxFreeBlocks = 512>
+class FreeListPool
+{
+    struct Block
+    {
+        Block* Next;
+    };
+
+    struct FreeList
+    {
+        FreeList() : Head(nullptr), Size(0) { }
+
+        ~FreeList()
+        {
+            while (Head)
+            {
+                Block* next = Head->Next;
+                ::operator delete(Head);
+                Head = next;
+            }
+        }
+
+        Block* Head;
+        uint32 Size;
+    };
+
+    public:
+        static void* Allocate(size_t size)
+        {
+            // derived classes have another size and do not use the pool
+            if (size == sizeof(T))
+            {
+                FreeList* list = GetFreeList();
+                if (Block* block = list->Head)
+                {
+                    list->Head = block->Next;
+                    --list->Size;
+                    ++_reuses;
+                    return block;
+                }
+            }
+
+            ++_heapAllocations;
+            return ::operator new(size);
+        }
+
+        static void Free(void* ptr, size_t size)
+        {
+            if (!ptr)
+                return;
+
+            if (size == sizeof(T))
+            {
+                FreeList* list = GetFreeList();
+                if (list->Size < MaxFreeBlocks)
+                {
+                    Block* block = static_cast<Block*>(ptr);
+                    block->Next = list->Head;
+                    list->Head = block;
+                    ++list->Size;
+                    return;
+                }
+            }
+
+            ::operator delete(ptr);
+        }
+
+        static FreeListPoolStats GetStats()
+        {
+            FreeListPoolStats stats;
+            stats.HeapAllocations = _heapAllocations;
+            stats.Reuses = _reuses;
+            return stats;
+        }
+
+    private:
+        static FreeList* GetFreeList()
+        {
+            FreeList* list = _freeList.get();
+            if (!list)
+            {
+                list = new FreeList();
+                _freeList.reset(list);
+            }
+
+            return list;
+        }
+
+        static boost::thread_specific_ptr<FreeList> _freeList;
+        static std::atomic<uint64> _heapAllocations;
+        static std::atomic<uint64> _reuses;
+};
+
+template<class T, uint32 MaxFreeBlocks>
+boost::thread_specific_ptr<typename FreeListPool<T, MaxFreeBlocks>::FreeList> FreeListPool<T, MaxFreeBlocks>::_freeList;
+
+template<class T, uint32 MaxFreeBlocks>
+std::atomic<uint64> FreeListPool<T, MaxFreeBlocks>::_heapAllocations(0);
+
+template<class T, uint32 MaxFreeBlocks>
+std::atomic<uint64> FreeListPool<T, MaxFreeBlocks>::_reuses(0);
+
+/*
+ * Allocator for node based containers like std::list and std::unordered_map, each node is taken
+ * from the FreeListPool of the node type. Arrays, such as the buckets of an unordered_map, have
+ * another size than a node and come from the heap.
+ */
+template<class T>
+class FreeListAllocator
+{
+    public:
+        typedef T value_type;
+
+        FreeListAllocator() { }
+        template<class U> FreeListAllocator(FreeListAllocator<U> const& /*right*/) { }
+
+        T* allocate(std::size_t count) { return static_cast<T*>(FreeListPool<T>::Allocate(count * sizeof(T))); }
+        void deallocate(T* ptr, std::size_t count) { FreeListPool<T>::Free(ptr, count * sizeof(T)); }
+
+        template<class U> bool operator==(FreeListAllocator<U> const& /*right*/) const { return true; }
+        template<class U> bool operator!=(FreeListAllocator<U> const& /*right*/) const { return false; }
+};
+
+#endif
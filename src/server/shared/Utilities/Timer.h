@@ -44,6 +44,19 @@ inline uint32 GetMSTimeDiffToNow(uint32 oldMSTime)
     return getMSTimeDiff(oldMSTime, getMSTime());
 }
 
+// Monotonic, microsecond precision - meant for profiling, not for game timers
+inline uint64 getUSTime()
+{
+    static const steady_clock::time_point ApplicationStartTime = steady_clock::now();
+
+    return uint64(duration_cast<microseconds>(steady_clock::now() - ApplicationStartTime).count());
+}
+
+inline uint64 GetUSTimeDiffToNow(uint64 oldUSTime)
+{
+    return getUSTime() - oldUSTime;
+}
+
 struct IntervalTimer
 {
 public:
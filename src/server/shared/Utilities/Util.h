@@ -346,13 +346,15 @@ uint32 CreatePIDFile(const std::string& filename);
 std::string ByteArrayToHexStr(uint8 const* bytes, uint32 length, bool reverse = false);
 
 // simple class for not-modifyable list
+// handlers are kept in one array, they are walked on every script hook call
 template <typename T>
 class HookList
 {
-    typedef typename std::list<T>::iterator ListIterator;
     private:
-        typename std::list<T> m_list;
+        typename std::vector<T> m_list;
     public:
+        typedef typename std::vector<T>::iterator iterator;
+
         HookList<T> & operator+=(T t)
         {
             m_list.push_back(t);
@@ -360,18 +362,22 @@ class HookList
         }
         HookList<T> & operator-=(T t)
         {
-            m_list.remove(t);
+            m_list.erase(std::remove(m_list.begin(), m_list.end(), t), m_list.end());
             return *this;
         }
-        size_t size()
+        size_t size() const
         {
             return m_list.size();
         }
-        ListIterator begin()
+        bool empty() const
+        {
+            return m_list.empty();
+        }
+        iterator begin()
         {
             return m_list.begin();
         }
-        ListIterator end()
+        iterator end()
         {
             return m_list.end();
         }